@@ -27,7 +27,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #define INCLUDE_CPP_COMMON_BASE_MATRIX_HPP_
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
+#include <limits>
 #include <vector>
 #include <map>
 
@@ -84,7 +86,31 @@ class Base_Matrix {
 
     /** @}*/
 
-    TInterval at(Idx i, Idx j) const {return m_time_matrix[i][j];}
+    /** @brief the cell (i, j) of the matrix
+     *
+     * Checks how the cells are stored on every call.
+     * The route evaluations choose the storage once per route with compact_at or wide_at
+     */
+    TInterval at(Idx i, Idx j) const {
+        return is_compact() ? compact_at(i, j) : wide_at(i, j);
+    }
+
+    /** @brief the cell (i, j) of a matrix stored in 32 bits
+     * @pre is_compact()
+     */
+    TInterval compact_at(Idx i, Idx j) const {
+        return from_compact(m_compact_cells[i * m_ids.size() + j]);
+    }
+
+    /** @brief the cell (i, j) of a matrix stored in 64 bits
+     * @pre not is_compact()
+     */
+    TInterval wide_at(Idx i, Idx j) const {
+        return m_cells[i * m_ids.size() + j];
+    }
+
+    /** @brief are the cells stored in 32 bits? */
+    bool is_compact() const {return !m_compact_cells.empty();}
 
 
     /** @brief print matrix (row per cell)*/
@@ -105,15 +131,41 @@ class Base_Matrix {
     /** @brief set the ids of the nodes */
     void set_ids(const std::vector<Matrix_cell_t> &);
 
+    /** @brief moves the rows of m_time_matrix to the storage used for reading */
+    void compact();
+
+    /** @brief moves the cells back to the rows of m_time_matrix */
+    void expand();
+
+    /** @brief fixes the triangle inequality on the rows of m_time_matrix */
+    size_t fix_rows_triangle_inequality(size_t depth);
+
+    /** value of a compact cell that represents infinity */
+    static constexpr int32_t compact_infinity = (std::numeric_limits<int32_t>::max)();
+
+    static TInterval from_compact(int32_t cell) {
+        return cell == compact_infinity ? (std::numeric_limits<TInterval>::max)() : cell;
+    }
+
     /** DATA **/
     /** ordered list of user identifiers */
     std::vector<Id> m_ids;
 
-    /** @brief the actual time matrix
+    /** @brief the time matrix while it is being built
      *
      * m_time_matrix[i][j] i and j are index from the ids
+     *
+     * Empty once the matrix is built: the cells are stored row by row on one of
+     * - m_compact_cells: when all the finite values fit in 32 bits
+     * - m_cells: otherwise
      */
     std::vector<std::vector<TInterval>> m_time_matrix;
+
+    /** @brief cells of the matrix: cell (i, j) is at i * size() + j */
+    std::vector<TInterval> m_cells;
+
+    /** @brief cells of the matrix in 32 bits: cell (i, j) is at i * size() + j */
+    std::vector<int32_t> m_compact_cells;
 };
 
 }  // namespace base
@@ -0,0 +1,206 @@
+/*PGR-GNU*****************************************************************
+
+FILE: dynamic_bitset.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_CPP_COMMON_DYNAMIC_BITSET_HPP_
+#define INCLUDE_CPP_COMMON_DYNAMIC_BITSET_HPP_
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace vrprouting {
+
+/** @brief Set of dense indices stored one bit per index
+ *
+ * The bits are stored in 64 bit words, so the set operations work a word at a time.
+ *
+ * Two threads can write to the same bitset only when they work on different words:
+ * - bits [64 * k, 64 * (k + 1)) belong to the k-th word
+ */
+class Dynamic_bitset {
+ public:
+    using Word = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    Dynamic_bitset() = default;
+
+    /** @brief bitset of @b n bits all unset */
+    explicit Dynamic_bitset(size_t n) :
+        m_size(n),
+        m_words(words_for(n), 0) {}
+
+    /** @brief number of bits (not the number of bits set) */
+    size_t size() const {return m_size;}
+
+    /** @brief changes the number of bits, new bits are unset */
+    void resize(size_t n) {
+        m_words.resize(words_for(n), 0);
+        m_size = n;
+        clear_tail();
+    }
+
+    /** @brief true when bit @b i is set */
+    bool test(size_t i) const {
+        return i < m_size && ((m_words[i / word_bits] >> (i % word_bits)) & Word(1));
+    }
+
+    /** @brief sets bit @b i, growing the bitset when needed */
+    void set(size_t i) {
+        if (i >= m_size) resize(i + 1);
+        m_words[i / word_bits] |= Word(1) << (i % word_bits);
+    }
+
+    /** @brief unsets bit @b i */
+    void reset(size_t i) {
+        if (i >= m_size) return;
+        m_words[i / word_bits] &= ~(Word(1) << (i % word_bits));
+    }
+
+    /** @brief unsets all the bits, the size is kept */
+    void reset() {
+        for (auto &w : m_words) w = 0;
+    }
+
+    /** @brief number of bits set */
+    size_t count() const {
+        size_t total = 0;
+        for (const auto w : m_words) total += popcount(w);
+        return total;
+    }
+
+    /** @brief true when no bit is set */
+    bool none() const {
+        for (const auto w : m_words) if (w) return false;
+        return true;
+    }
+
+    /** @brief number of bits set on both bitsets: popcount(this AND other) */
+    size_t count_and(const Dynamic_bitset &other) const {
+        auto n = std::min(m_words.size(), other.m_words.size());
+        size_t total = 0;
+        for (size_t w = 0; w < n; ++w) total += popcount(m_words[w] & other.m_words[w]);
+        return total;
+    }
+
+    /** @brief compound INTERSECTION */
+    Dynamic_bitset& operator&=(const Dynamic_bitset &other) {
+        auto n = std::min(m_words.size(), other.m_words.size());
+        for (size_t w = 0; w < n; ++w) m_words[w] &= other.m_words[w];
+        for (size_t w = n; w < m_words.size(); ++w) m_words[w] = 0;
+        return *this;
+    }
+
+    /** @brief compound UNION, grows to the size of @b other when needed */
+    Dynamic_bitset& operator|=(const Dynamic_bitset &other) {
+        if (other.m_size > m_size) resize(other.m_size);
+        for (size_t w = 0; w < other.m_words.size(); ++w) m_words[w] |= other.m_words[w];
+        return *this;
+    }
+
+    /** @brief compound DIFFERENCE */
+    Dynamic_bitset& operator-=(const Dynamic_bitset &other) {
+        auto n = std::min(m_words.size(), other.m_words.size());
+        for (size_t w = 0; w < n; ++w) m_words[w] &= ~other.m_words[w];
+        return *this;
+    }
+
+    /** @returns the first set bit at or after @b i, size() when there is none */
+    size_t find_next(size_t i) const {
+        if (i >= m_size) return m_size;
+        auto w = i / word_bits;
+        auto word = m_words[w] & (~Word(0) << (i % word_bits));
+        while (!word) {
+            if (++w == m_words.size()) return m_size;
+            word = m_words[w];
+        }
+        return w * word_bits + lowest_bit(word);
+    }
+
+    /** @returns the first set bit, size() when there is none */
+    size_t find_first() const {return find_next(0);}
+
+    /** @returns the last set bit, size() when there is none */
+    size_t find_last() const {
+        for (auto w = m_words.size(); w-- > 0; ) {
+            if (m_words[w]) return w * word_bits + highest_bit(m_words[w]);
+        }
+        return m_size;
+    }
+
+    /** @brief the storage words */
+    const std::vector<Word>& words() const {return m_words;}
+
+    /** @brief number of bits set on a word */
+    static size_t popcount(Word w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(w));
+#else
+        size_t c = 0;
+        for (; w; w &= w - 1) ++c;
+        return c;
+#endif
+    }
+
+    /** @brief position of the highest bit set on a non zero word */
+    static size_t highest_bit(Word w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return word_bits - 1 - static_cast<size_t>(__builtin_clzll(w));
+#else
+        size_t c = 0;
+        for (; w >>= 1; ) ++c;
+        return c;
+#endif
+    }
+
+    /** @brief position of the lowest bit set on a non zero word */
+    static size_t lowest_bit(Word w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(w));
+#else
+        size_t c = 0;
+        for (; !(w & Word(1)); w >>= 1) ++c;
+        return c;
+#endif
+    }
+
+ private:
+    static size_t words_for(size_t n) {return (n + word_bits - 1) / word_bits;}
+
+    /** @brief keeps the bits after size() unset */
+    void clear_tail() {
+        if (m_size % word_bits) {
+            m_words.back() &= ~(~Word(0) << (m_size % word_bits));
+        }
+    }
+
+    size_t m_size {0};
+    std::vector<Word> m_words;
+};
+
+}  // namespace vrprouting
+
+#endif  // INCLUDE_CPP_COMMON_DYNAMIC_BITSET_HPP_
@@ -0,0 +1,123 @@
+/*PGR-GNU*****************************************************************
+
+FILE: fingerprint_set.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_CPP_COMMON_FINGERPRINT_SET_HPP_
+#define INCLUDE_CPP_COMMON_FINGERPRINT_SET_HPP_
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace vrprouting {
+
+/** @brief mixes the bits of a 64 bit value (splitmix64 finalizer) */
+inline uint64_t
+hash_mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/** @brief hash of the sequence (@b seed, @b value) */
+inline uint64_t
+hash_combine(uint64_t seed, uint64_t value) {
+    return hash_mix(seed ^ hash_mix(value));
+}
+
+/** @brief Set of 64 bit fingerprints with a bounded memory
+ *
+ * - The slots are grouped in buckets of bucket_slots, a fingerprint can only be on its bucket
+ * - When the bucket of a new fingerprint is full, one of the fingerprints of the bucket is forgotten
+ * - The memory is allocated on the first insertion
+ *
+ * Forgetting a fingerprint means that @b has can return false for a fingerprint that was inserted:
+ * use it for information that can be computed again.
+ */
+class Fingerprint_set {
+ public:
+    static constexpr size_t bucket_slots = 4;
+
+    /** @brief set that uses at most @b capacity slots (rounded up to a power of 2) */
+    explicit Fingerprint_set(size_t capacity = default_capacity) {
+        size_t buckets = 1;
+        while (buckets * bucket_slots < capacity) buckets <<= 1;
+        m_mask = buckets - 1;
+    }
+
+    /** @brief is the fingerprint on the set? */
+    bool has(uint64_t fingerprint) const {
+        if (m_slots.empty()) return false;
+        fingerprint = not_empty(fingerprint);
+        auto first = bucket(fingerprint);
+        for (size_t s = 0; s < bucket_slots; ++s) {
+            if (m_slots[first + s] == fingerprint) return true;
+        }
+        return false;
+    }
+
+    /** @brief inserts the fingerprint, forgetting another one when its bucket is full */
+    void insert(uint64_t fingerprint) {
+        if (m_slots.empty()) m_slots.assign((m_mask + 1) * bucket_slots, empty_slot);
+        fingerprint = not_empty(fingerprint);
+        auto first = bucket(fingerprint);
+        for (size_t s = 0; s < bucket_slots; ++s) {
+            auto &slot = m_slots[first + s];
+            if (slot == fingerprint) return;
+            if (slot == empty_slot) {
+                slot = fingerprint;
+                return;
+            }
+        }
+        /* bucket is full: the high bits of the fingerprint choose who is forgotten */
+        m_slots[first + static_cast<size_t>(fingerprint >> 32) % bucket_slots] = fingerprint;
+    }
+
+    /** @brief forgets all the fingerprints and releases the memory */
+    void clear() {
+        std::vector<uint64_t>().swap(m_slots);
+    }
+
+ private:
+    static constexpr size_t default_capacity = size_t(1) << 18;
+    static constexpr uint64_t empty_slot = 0;
+
+    /** @brief 0 marks an empty slot */
+    static uint64_t not_empty(uint64_t fingerprint) {
+        return fingerprint == empty_slot ? 1 : fingerprint;
+    }
+
+    size_t bucket(uint64_t fingerprint) const {
+        return static_cast<size_t>(fingerprint & m_mask) * bucket_slots;
+    }
+
+    size_t m_mask;
+    std::vector<uint64_t> m_slots;
+};
+
+}  // namespace vrprouting
+
+#endif  // INCLUDE_CPP_COMMON_FINGERPRINT_SET_HPP_
@@ -43,6 +43,8 @@ File from pgRouting
 #include <iostream>
 #include <stdexcept>
 
+#include "cpp_common/dynamic_bitset.hpp"
+
 /* TODO(vicky)
  * compiler check that type T is a integral type
  */
@@ -79,7 +81,7 @@ class Identifiers {
     size_t size() const {return m_ids.size(); }
     inline bool empty() const {return m_ids.empty(); }
     inline T front() const {return *m_ids.begin();}
-    inline T back() const {return *m_ids.end();}
+    inline T back() const {return *m_ids.rbegin();}
     const_iterator begin() const {return m_ids.begin();}
     const_iterator end() const {return m_ids.end();}
 
@@ -254,4 +256,190 @@ class Identifiers {
         }
 };
 
+
+/** @brief Identifiers of dense indices
+ *
+ * The solver's bookkeeping works on indices of orders and vehicles:
+ * - the values are 0 ... n-1
+ *
+ * This variant stores the set in a bitset instead of a tree:
+ * - `has`, `+=` and `-=` of an element are constant time and do not allocate
+ * - the set operators work a word (64 indices) at a time
+ * - the iteration is in ascending order, like the generic version
+ */
+template <>
+class Identifiers<size_t> {
+ public:
+    /** @brief forward iterator over the indices in the set */
+    class const_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        const_iterator(const vrprouting::Dynamic_bitset *bits, size_t pos) :
+            m_bits(bits),
+            m_pos(pos) {}
+
+        size_t operator*() const {return m_pos;}
+
+        const_iterator& operator++() {
+            m_pos = m_bits->find_next(m_pos + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator &rhs) const {return m_pos == rhs.m_pos;}
+        bool operator!=(const const_iterator &rhs) const {return m_pos != rhs.m_pos;}
+
+     private:
+        const vrprouting::Dynamic_bitset *m_bits;
+        size_t m_pos;
+    };
+    typedef const_iterator iterator;
+
+
+    //! @name constructors
+    //@{
+    Identifiers() = default;
+    Identifiers(const std::set<size_t>& data) {
+        for (const auto e : data) m_ids.set(e);
+    }
+
+    /* @brief initializes with {0 ~ number - 1}
+     *
+     * @params [in] number
+     */
+    explicit Identifiers(const size_t number) :
+        m_ids(number) {
+        for (size_t i = 0; i < number; ++i) m_ids.set(i);
+    }
+
+    /* @brief initializes with the bits set on @b data */
+    explicit Identifiers(const vrprouting::Dynamic_bitset& data) :
+        m_ids(data) {}
+    //@}
+
+    //! @name set like operators
+    //@{
+    size_t size() const {return m_ids.count();}
+    inline bool empty() const {return m_ids.none();}
+    inline size_t front() const {return m_ids.find_first();}
+    inline size_t back() const {return m_ids.find_last();}
+    const_iterator begin() const {return const_iterator(&m_ids, m_ids.find_first());}
+    const_iterator end() const {return const_iterator(&m_ids, m_ids.size());}
+
+    inline void pop_front() {m_ids.reset(m_ids.find_first());}
+
+    inline void clear() {m_ids.reset();}
+    //@}
+
+    /** @brief the set as a bitset */
+    const vrprouting::Dynamic_bitset& bits() const {return m_ids;}
+
+ private:
+    vrprouting::Dynamic_bitset m_ids;
+
+ public:
+    //! \brief true ids() has element
+    bool has(const size_t other) const {return m_ids.test(other);}
+
+    //! \brief true when both sets are equal
+    bool operator==(const Identifiers<size_t> &rhs) const {
+        const auto &lhs_w = m_ids.words();
+        const auto &rhs_w = rhs.m_ids.words();
+        auto n = (std::max)(lhs_w.size(), rhs_w.size());
+        for (size_t w = 0; w < n; ++w) {
+            auto l = w < lhs_w.size() ? lhs_w[w] : 0;
+            auto r = w < rhs_w.size() ? rhs_w[w] : 0;
+            if (l != r) return false;
+        }
+        return true;
+    }
+
+    //! @name  set UNION
+    /// @{
+    friend Identifiers<size_t> operator +(
+            const Identifiers<size_t> &lhs,
+            const Identifiers<size_t> &rhs) {
+        Identifiers<size_t> union_ids(lhs);
+        union_ids += rhs;
+        return union_ids;
+    }
+
+    Identifiers<size_t>& operator +=(const Identifiers<size_t> &other) {
+        m_ids |= other.m_ids;
+        return *this;
+    }
+
+    Identifiers<size_t>& operator +=(const size_t &element) {
+        m_ids.set(element);
+        return *this;
+    }
+    /// @}
+
+    //! @name  set INTERSECTION
+    /// @{
+    friend Identifiers<size_t> operator *(
+            const Identifiers<size_t> &lhs,
+            const Identifiers<size_t> &rhs) {
+        Identifiers<size_t> result(lhs);
+        result *= rhs;
+        return result;
+    }
+
+    Identifiers<size_t>& operator *=(const Identifiers<size_t> &other) {
+        m_ids &= other.m_ids;
+        return *this;
+    }
+
+    Identifiers<size_t>& operator *=(const size_t &element) {
+        auto found = has(element);
+        m_ids.reset();
+        if (found) m_ids.set(element);
+        return *this;
+    }
+    /// @}
+
+    //! @name  set DIFFERENCE
+    /// @{
+    friend Identifiers<size_t> operator -(
+            const Identifiers<size_t> &lhs,
+            const Identifiers<size_t> &rhs) {
+        Identifiers<size_t> result(lhs);
+        result -= rhs;
+        return result;
+    }
+
+    Identifiers<size_t>& operator -=(const Identifiers<size_t> &other) {
+        m_ids -= other.m_ids;
+        return *this;
+    }
+
+    Identifiers<size_t>& operator -=(const size_t &element) {
+        m_ids.reset(element);
+        return *this;
+    }
+    /// @}
+
+    //! \brief Prints the set of identifiers
+    friend
+        std::ostream&
+        operator<<(std::ostream& os, const Identifiers<size_t>& identifiers) {
+            os << "{";
+            for (auto identifier : identifiers) {
+                os << identifier << ", ";
+            }
+            os << "}";
+            return os;
+        }
+};
+
 #endif  // INCLUDE_CPP_COMMON_IDENTIFIERS_HPP_
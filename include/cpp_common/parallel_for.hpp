@@ -0,0 +1,107 @@
+/*PGR-GNU*****************************************************************
+
+FILE: parallel_for.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_CPP_COMMON_PARALLEL_FOR_HPP_
+#define INCLUDE_CPP_COMMON_PARALLEL_FOR_HPP_
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace vrprouting {
+
+/** @brief number of worker threads to use */
+inline size_t
+hardware_threads() {
+    auto n = static_cast<size_t>(std::thread::hardware_concurrency());
+    return n ? n : 1;
+}
+
+/** @brief Calls @b work on consecutive ranges of [first, last) using several threads
+ *
+ * @param [in] first, last the range of positions to process
+ * @param [in] grain the ranges given to the threads are multiples of @b grain
+ * @param [in] work callable with signature `void(size_t begin, size_t end)`
+ * @param [in] max_threads maximum number of threads, the calling thread included: 1 processes the range here
+ *
+ * - A thread gets at least @b grain positions: a range of @b grain positions or less is processed here
+ * - The calling thread processes the first range
+ * - The first exception thrown by any range is re-thrown after all threads finish
+ *
+ * @warning @b work must not call the postgres API, that includes `CHECK_FOR_INTERRUPTS`
+ */
+template <typename Work>
+void
+parallel_for(size_t first, size_t last, size_t grain, Work work, size_t max_threads = hardware_threads()) {
+    if (last <= first) return;
+    grain = std::max(grain, size_t(1));
+
+    auto blocks = (last - first + grain - 1) / grain;
+    auto n_threads = std::min({hardware_threads(), max_threads, blocks});
+    if (n_threads <= 1) {
+        work(first, last);
+        return;
+    }
+
+    auto per_thread = ((blocks + n_threads - 1) / n_threads) * grain;
+
+    std::vector<std::exception_ptr> errors(n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+
+    auto run = [&](size_t t) {
+        auto b = first + t * per_thread;
+        auto e = std::min(last, b + per_thread);
+        if (b >= e) return;
+        try {
+            work(b, e);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    size_t t = 1;
+    try {
+        for (; t < n_threads; ++t) {
+            threads.emplace_back(run, t);
+        }
+    } catch (...) {
+        /* could not create more threads: the remaining ranges are processed here */
+        for (auto pending = t; pending < n_threads; ++pending) run(pending);
+    }
+    run(0);
+    for (auto &thread : threads) thread.join();
+
+    for (const auto &e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+}  // namespace vrprouting
+
+#endif  // INCLUDE_CPP_COMMON_PARALLEL_FOR_HPP_
@@ -0,0 +1,87 @@
+/*PGR-GNU*****************************************************************
+
+FILE: time_limit.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_CPP_COMMON_TIME_LIMIT_HPP_
+#define INCLUDE_CPP_COMMON_TIME_LIMIT_HPP_
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace vrprouting {
+
+/** @brief Wall clock time given to a process
+ *
+ * The clock starts when the object is created.
+ * Checking the limit only reads the clock: it can be done inside the loops
+ * and from several threads.
+ *
+ * The work done by a thread can also be cancelled by another thread with a shared flag.
+ */
+class Time_limit {
+    using Clock = std::chrono::steady_clock;
+
+ public:
+    /** @brief A limit of @b milliseconds, a negative value means no limit
+     *
+     * A limit that the clock can not represent is saturated to the end of the clock
+     */
+    explicit Time_limit(int64_t milliseconds = -1) :
+        m_limited(milliseconds >= 0),
+        m_end(end_of(m_limited ? milliseconds : 0)) {}
+
+    /** @brief The same limit, that is also reached when @b cancelled is true */
+    Time_limit(const Time_limit &limit, const std::atomic<bool> &cancelled) :
+        m_limited(limit.m_limited),
+        m_end(limit.m_end),
+        m_cancelled(&cancelled) {}
+
+    /** @brief is there a limit? */
+    bool is_limited() const {return m_limited;}
+
+    /** @brief the time given is over or the work was cancelled */
+    bool reached() const {
+        return (m_cancelled && m_cancelled->load(std::memory_order_relaxed))
+            || (m_limited && Clock::now() >= m_end);
+    }
+
+ private:
+    /** @brief now + @b milliseconds, without overflowing the clock */
+    static Clock::time_point end_of(int64_t milliseconds) {
+        auto now = Clock::now();
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::time_point::max() - now);
+        return std::chrono::milliseconds(milliseconds) < left ?
+            now + std::chrono::milliseconds(milliseconds) : Clock::time_point::max();
+    }
+
+    bool m_limited;
+    Clock::time_point m_end;
+    const std::atomic<bool> *m_cancelled {nullptr};
+};
+
+}  // namespace vrprouting
+
+#endif  // INCLUDE_CPP_COMMON_TIME_LIMIT_HPP_
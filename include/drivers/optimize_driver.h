@@ -49,7 +49,7 @@ extern "C" {
 
 void vrp_do_optimize(
         char*, char*, char*, char*,
-        double, int, int64_t, bool, int, bool, bool, bool,
+        double, int, int64_t, int, bool, int, bool, bool, bool,
 
         Short_vehicle_rt**, size_t*,
         char**, char**, char**);
@@ -48,7 +48,7 @@ extern "C" {
 
 void vrp_do_pgr_pickDeliverEuclidean(
         char*, char*,
-        double, int, int,
+        double, int, int, int,
 
         Solution_rt**, size_t*,
         char**, char**, char**);
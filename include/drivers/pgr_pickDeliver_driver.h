@@ -49,7 +49,7 @@ extern "C" {
 
 void vrp_do_pgr_pickDeliver(
         char*, char*, char*,
-        double, int, int,
+        double, int, int, int,
 
         Solution_rt**, size_t*,
         char**, char**, char**);
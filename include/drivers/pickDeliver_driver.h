@@ -50,7 +50,7 @@ extern "C" {
   /** @brief Driver for processing a pickupDeliver problem */
 void vrp_do_pickDeliver(
         char*, char*, char*, char*,
-        double, int, int64_t, bool, bool, bool, bool, bool,
+        double, int, int64_t, bool, bool, int, int, int, int, bool, bool, bool,
 
         Solution_rt**, size_t*,
         char**, char**, char**);
@@ -42,7 +42,8 @@ enum Initials_code {
     BestInsert,  /*! Best place to insert Order */
     BestBack,    /*! Push back order that allows more orders to be inserted at the back */
     BestFront,   /*! Push front order that allows more orders to be inserted at the front */
-    OneDepot     /*! Pick at front, drop at back, OneDepot for all vehicles */
+    OneDepot,    /*! Pick at front, drop at back, OneDepot for all vehicles */
+    Savings      /*! Merge the routes of the orders that save more travel time */
 };
 
 }  // namespace simple
@@ -0,0 +1,160 @@
+/*PGR-GNU*****************************************************************
+
+FILE: regret.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/** @file */
+
+#ifndef INCLUDE_INITIALSOL_REGRET_HPP_
+#define INCLUDE_INITIALSOL_REGRET_HPP_
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/parallel_for.hpp"
+#include "cpp_common/time_limit.hpp"
+#include "problem/orders.hpp"
+#include "problem/solution.hpp"
+#include "problem/vehicle_pickDeliver.hpp"
+
+namespace vrprouting {
+namespace initialsol {
+namespace regret {
+
+/** @brief Regret-k insertion of orders on the vehicles of a fleet
+ *
+ * - the costs of inserting each order on each vehicle are computed using several threads
+ * - each order keeps its @b k cheapest vehicles, its regret is what is lost when it is not inserted on the cheapest one
+ * - the order with the biggest regret is inserted first, orders with less than @b k vehicles go before the others
+ * - after an insertion only the costs on the vehicle that changed are computed again
+ *
+ * With @b k = 1 it is the greedy insertion: the cheapest order is inserted first.
+ */
+class Insertion {
+ public:
+    /** @brief Insertion on the vehicles of @b fleet */
+    Insertion(std::deque<problem::Vehicle_pickDeliver> &fleet, const problem::Orders &orders, size_t k,
+            const Time_limit&, size_t threads);
+
+    /** @brief inserts the orders of @b pool while there is one that fits */
+    std::vector<bool> insert(const std::vector<size_t> &pool,
+            const std::function<void(size_t)> &before_insertion = nullptr);
+
+ private:
+    /** @brief Priority of an order, smaller goes first */
+    struct Entry {
+        /** vehicles where the order can be inserted, up to k */
+        size_t options;
+        /** sum of the differences between the k - 1 next cheapest vehicles and the cheapest one */
+        TInterval regret;
+        /** cost on the cheapest vehicle */
+        TInterval best;
+        /** position of the order on m_pool */
+        size_t position;
+
+        bool operator<(const Entry &rhs) const {
+            if (options != rhs.options) return options < rhs.options;
+            if (regret != rhs.regret) return regret > rhs.regret;
+            if (best != rhs.best) return best < rhs.best;
+            return position < rhs.position;
+        }
+    };
+
+    /** @brief computes the costs of the orders on vehicle @b v after it changed */
+    void update(size_t v);
+
+    /** @brief the cost on vehicle @b v of the order on position @b p changed to @b d */
+    void consider(size_t p, size_t v, TInterval d);
+
+    /** @brief the cheapest vehicles of the order on position @b p from its costs */
+    void choose(size_t p);
+
+    /** @brief the order on position @b p gets the entry of its cheapest vehicles */
+    void enqueue(size_t p);
+
+    /** @brief the cost of the order on position @b p on vehicle @b v */
+    TInterval& delta(size_t p, size_t v) {return m_delta[p * m_fleet.size() + v];}
+
+    /** Minimum number of orders evaluated by a thread after an insertion */
+    static constexpr size_t orders_per_thread = 16;
+
+    /** Vehicles where the orders are inserted */
+    std::deque<problem::Vehicle_pickDeliver> &m_fleet;
+
+    /** Orders of the problem */
+    const problem::Orders &m_orders;
+
+    /** Number of vehicles used to compute the regret */
+    size_t m_k;
+
+    /** When the time is over the orders not inserted stay out of the vehicles */
+    Time_limit m_time_limit;
+
+    /** Maximum number of threads that compute the costs */
+    size_t m_threads;
+
+    /** Orders to be inserted */
+    std::vector<size_t> m_pool;
+
+    /** The order on the position was inserted */
+    std::vector<bool> m_inserted;
+
+    /** position of the order * number of vehicles + vehicle -> cost of the insertion */
+    std::vector<TInterval> m_delta;
+
+    /** position of the order -> its k cheapest vehicles, cheapest first */
+    std::vector<std::vector<size_t>> m_cheapest;
+
+    /** position of the order -> its entry on m_queue */
+    std::vector<Entry> m_entries;
+
+    /** Orders that can be inserted, the first one is inserted next */
+    std::set<Entry> m_queue;
+};
+
+/** @brief Initial solution built with a regret-k insertion
+ *
+ * The orders on phony vehicles are inserted on the real vehicles with a regret-k Insertion.
+ *
+ * The orders that can not be inserted stay on phony vehicles, one order per vehicle.
+ */
+class Initial_solution : public problem::Solution {
+ public:
+    /** @brief Initial solution without information is not valid */
+    Initial_solution() = delete;
+
+    /** @brief Inserting the orders that are on the phony vehicles of @b solution */
+    Initial_solution(const problem::Solution &solution, size_t k, const Time_limit& = Time_limit(),
+            size_t threads = hardware_threads());
+};
+
+}  //  namespace regret
+}  //  namespace initialsol
+}  //  namespace vrprouting
+
+#endif  // INCLUDE_INITIALSOL_REGRET_HPP_
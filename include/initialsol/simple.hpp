@@ -57,6 +57,11 @@ class Initial_solution : public problem::Solution {
 
     void do_while_foo(Initials_code);
 
+    /*
+     * Clarke & Wright savings for pickup & delivery orders
+     */
+    void savings();
+
     void do_while_feasible(
         problem::Vehicle_pickDeliver& truck,
         Initials_code kind,
@@ -0,0 +1,267 @@
+/*PGR-GNU*****************************************************************
+
+FILE: alns.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/** @file */
+
+#ifndef INCLUDE_OPTIMIZERS_ALNS_HPP_
+#define INCLUDE_OPTIMIZERS_ALNS_HPP_
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/fingerprint_set.hpp"
+#include "cpp_common/identifiers.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "cpp_common/time_limit.hpp"
+#include "problem/solution.hpp"
+
+namespace vrprouting {
+namespace optimizers {
+namespace alns {
+
+/** @brief Class that optimizes a solution with an Adaptive Large Neighbourhood Search
+ *
+ * On each iteration some orders are removed from the routes (ruin)
+ * and the unassigned orders are inserted again (recreate).
+ *
+ * - ruin operators: random, related, worst and route removal
+ * - recreate operators: greedy and regret-2 insertion
+ * - the operators are chosen with a roulette wheel, their weights adapt to how they performed
+ * - the new solution is accepted with a simulated annealing criterion
+ *
+ * A solution with less unassigned orders is always better, then the smallest total travel time is better.
+ *
+ * The random numbers use a fixed seed: the same problem gets the same solution.
+ *
+ * How to use:
+ *
+ * ~~~~{.c}
+ * // Given a solution in solution_to_optimize
+ * // in this example it is one cycle and to stop when all orders are served
+ *
+ * Solution optimized_solution = Optimize(solution_to_optimize, 1, true);
+ * ~~~~
+ */
+class Optimize : public problem::Solution {
+ public:
+    /** @brief Optimization operation */
+    Optimize(const problem::Solution& solution, size_t times, bool stop_on_all_served, bool,
+            const Time_limit& = Time_limit(), size_t threads = hardware_threads());
+
+ private:
+    /** @brief ruin operators */
+    enum Ruin {kRandomRemoval, kRelatedRemoval, kWorstRemoval, kRouteRemoval, kRuins};
+
+    /** @brief recreate operators */
+    enum Recreate {kGreedyInsertion, kRegretInsertion, kRecreates};
+
+    /** @brief value of a solution: the number of unassigned orders then the total travel time */
+    struct Cost {
+        size_t unassigned;
+        TInterval travel_time;
+
+        bool operator<(const Cost &rhs) const {
+            return unassigned < rhs.unassigned
+                || (unassigned == rhs.unassigned && travel_time < rhs.travel_time);
+        }
+    };
+
+    /** @brief Weights of a group of operators
+     *
+     * The scores of an operator are added during a segment of iterations,
+     * at the end of the segment the weight moves towards the average score.
+     */
+    struct Weights {
+        explicit Weights(size_t n) : weight(n, 1.0), score(n, 0.0), uses(n, 0) {}
+
+        /** @brief chooses an operator with a probability proportional to its weight */
+        size_t select(double random) const;
+
+        /** @brief the segment is over: updates the weights, keeping them over @b floor */
+        void update(double reaction, double floor);
+
+        std::vector<double> weight;
+        std::vector<double> score;
+        std::vector<size_t> uses;
+    };
+
+    /** @brief The best solution: the routes of the real vehicles and the unassigned orders */
+    struct Best_solution {
+        std::vector<problem::Vehicle_pickDeliver::Route> routes;
+        Identifiers<size_t> unassigned;
+        Cost cost;
+    };
+
+    /** @brief Main optimization controller */
+    void alns_search();
+
+    /** @brief inserts the unassigned orders one by one on the vehicle where it costs less */
+    void first_solution();
+
+    /** @brief removes @b q orders from the routes */
+    void ruin(Ruin, size_t q);
+
+    void random_removal(size_t q);
+    void related_removal(size_t q);
+    void worst_removal(size_t q);
+    void route_removal(size_t q);
+
+    /** @brief inserts the unassigned orders on the routes */
+    void recreate(Recreate);
+
+    /** @brief how related are two orders: smaller is more related */
+    TInterval relatedness(size_t o_id1, size_t o_id2) const;
+
+    /** @brief moves the order from vehicle @b v to the unassigned orders */
+    void remove_order(size_t v, size_t o_id);
+
+    /** @brief keeps the route of vehicle @b v before it changes on this iteration */
+    void touch(size_t v);
+
+    /** @brief the changes of this iteration are kept */
+    void accept();
+
+    /** @brief the changes of this iteration are undone */
+    void reject();
+
+    /** @brief the vehicle that has each assigned order, the number of vehicles for unassigned orders */
+    std::vector<size_t> vehicle_of_orders() const;
+
+    /** @brief value of the current solution */
+    Cost current_cost() const;
+
+    /** @brief fingerprint of the current solution */
+    uint64_t solution_hash() const;
+
+    /** @brief keeps the current solution as the best solution */
+    void save_best();
+
+    /** @brief the current solution becomes the best solution */
+    void restore_best();
+
+    /** @brief random number in [0, 1) */
+    double random01() {return static_cast<double>(m_rng()) / 4294967296.0;}
+
+    /** @brief random number in [0, n) */
+    size_t random_index(size_t n) {return static_cast<size_t>(random01() * static_cast<double>(n));}
+
+    /** Minimum number of vehicles evaluated by a thread: smaller fleets are evaluated on this thread */
+    static constexpr size_t vehicles_per_thread = 16;
+
+    /** Iterations done per cycle */
+    static constexpr size_t iterations_per_cycle = 100;
+
+    /** Iterations on a segment of the adaptive weights */
+    static constexpr size_t segment_length = 100;
+
+    /** How fast the weights follow the scores */
+    static constexpr double reaction = 0.1;
+
+    /** Smallest weight of an operator: all the operators keep being used */
+    static constexpr double min_weight = 0.05;
+
+    /** Score of an operator that found a new best solution */
+    static constexpr double score_best = 33;
+
+    /** Score of an operator that found a solution better than the current one */
+    static constexpr double score_better = 9;
+
+    /** Score of an operator that found a new worse solution that was accepted */
+    static constexpr double score_accepted = 13;
+
+    /** Fewest orders removed by a ruin operator */
+    static constexpr size_t min_removed = 4;
+
+    /** Most orders removed by a ruin operator */
+    static constexpr size_t max_removed = 100;
+
+    /** Most orders removed by a ruin operator as a fraction of the assigned orders */
+    static constexpr double max_removed_fraction = 0.4;
+
+    /** Randomness of the related removal: a higher value chooses the most related orders more often */
+    static constexpr double related_determinism = 6;
+
+    /** Randomness of the worst removal: a higher value chooses the most expensive orders more often */
+    static constexpr double worst_determinism = 3;
+
+    /** The starting temperature accepts a solution this much worse than the first one... */
+    static constexpr double start_worsening = 0.05;
+
+    /** ... with this probability */
+    static constexpr double start_probability = 0.5;
+
+    /** The temperature at the last iteration as a fraction of the starting temperature */
+    static constexpr double end_temperature = 0.002;
+
+    /** Maximum number of cycles on the optimization process */
+    size_t m_max_cycles;
+
+    /** Flag to stop when all orders are in real vehicles */
+    bool m_stop_on_all_served;
+
+    /** Flag to just build a solution and not optimize it */
+    bool m_optimize;
+
+    /** When the time is over the best solution found so far is kept */
+    Time_limit m_time_limit;
+
+    /** Maximum number of threads that evaluate the vehicles */
+    size_t m_threads;
+
+    /** Generator of the random numbers */
+    std::mt19937 m_rng {1};
+
+    /** Orders that are not on a real vehicle */
+    Identifiers<size_t> m_unassigned;
+
+    Weights m_ruin_weights {kRuins};
+    Weights m_recreate_weights {kRecreates};
+
+    /** Routes of the vehicles before they changed on this iteration */
+    std::vector<std::pair<size_t, problem::Vehicle_pickDeliver::Route>> m_changed;
+
+    /** Vehicles with a route on m_changed */
+    std::vector<bool> m_is_changed;
+
+    /** Unassigned orders before this iteration */
+    Identifiers<size_t> m_prev_unassigned;
+
+    /** Solutions that were accepted */
+    Fingerprint_set m_visited;
+
+    /** The best solution so far */
+    Best_solution m_best;
+};
+
+}  //  namespace alns
+}  //  namespace optimizers
+}  //  namespace vrprouting
+
+#endif  // INCLUDE_OPTIMIZERS_ALNS_HPP_
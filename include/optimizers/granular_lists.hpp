@@ -0,0 +1,94 @@
+/*PGR-GNU*****************************************************************
+
+FILE: granular_lists.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/** @file */
+
+#ifndef INCLUDE_OPTIMIZERS_GRANULAR_LISTS_HPP_
+#define INCLUDE_OPTIMIZERS_GRANULAR_LISTS_HPP_
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/dynamic_bitset.hpp"
+
+namespace vrprouting {
+namespace problem {
+class Orders;
+class Order;
+class Vehicle_pickDeliver;
+}  // namespace problem
+
+namespace optimizers {
+namespace tabu {
+
+/** @brief For each order, the real vehicles whose routes are near the order
+ *
+ * The distance between an order and a route is the smallest distance between the order and a node of the route:
+ * - the travel time from the node to the pickup or from the delivery to the node
+ * - plus the gap between the time window of the node and the time span of the order
+ *
+ * Each order keeps the @b k vehicles with the smallest distance (ties by vehicle idx).
+ *
+ * The lists are kept per route_hash() of the vehicles: the copies of a vehicle share its identifier, not its route.
+ * The distances of a vehicle are computed again only when its route changed.
+ */
+class Granular_lists {
+ public:
+    /** @brief lists of @b k vehicles per order */
+    explicit Granular_lists(size_t k) : m_k(k) {}
+
+    /** @brief updates the lists with the routes of the fleet that changed */
+    void update(const std::deque<problem::Vehicle_pickDeliver> &fleet, const problem::Orders &orders,
+            size_t threads);
+
+    /** @brief the orders that have the vehicle on their list */
+    const Dynamic_bitset& near_orders(const problem::Vehicle_pickDeliver &vehicle) const;
+
+ private:
+    /** @brief distance from the order to the route of the vehicle */
+    static TInterval distance(const problem::Vehicle_pickDeliver &vehicle, const problem::Order &order);
+
+    /** number of vehicles on the list of an order */
+    size_t m_k;
+
+    /** route_hash() of the vehicle -> order -> distance */
+    std::unordered_map<uint64_t, std::vector<TInterval>> m_distances;
+
+    /** route_hash() of the vehicle -> orders that have the vehicle on their list */
+    std::unordered_map<uint64_t, Dynamic_bitset> m_near_orders;
+
+    /** a vehicle that is on no list */
+    Dynamic_bitset m_none;
+};
+
+}  // namespace tabu
+}  // namespace optimizers
+}  // namespace vrprouting
+
+#endif  // INCLUDE_OPTIMIZERS_GRANULAR_LISTS_HPP_
@@ -0,0 +1,178 @@
+/*PGR-GNU*****************************************************************
+
+FILE: multi_start.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/** @file */
+
+#ifndef INCLUDE_OPTIMIZERS_MULTI_START_HPP_
+#define INCLUDE_OPTIMIZERS_MULTI_START_HPP_
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cpp_common/time_limit.hpp"
+#include "problem/solution.hpp"
+
+namespace vrprouting {
+namespace optimizers {
+namespace tabu {
+
+/** @brief Best solution shared by the trajectories of a multi-start search
+ *
+ * Every few cycles the active trajectories meet:
+ * - the trajectory with the best solution of the meeting gives it when it is better than the incumbent
+ * - the trajectory with the worst solution of the meeting restarts from the incumbent when it is far from it,
+ *   trajectory 0 never restarts
+ *
+ * The meetings wait for all the active trajectories, so the result does not depend on the speed of the threads.
+ */
+class Incumbent {
+ public:
+    /** @brief value of a solution of a trajectory, smaller is better */
+    struct Key {
+        /** orders on phony vehicles */
+        size_t unassigned;
+        double objective;
+        /** ties are broken by the number of the trajectory */
+        size_t trajectory;
+
+        bool operator<(const Key &rhs) const {
+            if (unassigned != rhs.unassigned) return unassigned < rhs.unassigned;
+            if (objective != rhs.objective) return objective < rhs.objective;
+            return trajectory < rhs.trajectory;
+        }
+    };
+
+    /** @brief the incumbent of @b trajectories trajectories */
+    explicit Incumbent(size_t trajectories);
+
+    /** @brief key of the solution of a trajectory */
+    static Key key(const problem::Solution &solution, size_t trajectory);
+
+    /** @brief meeting of the active trajectories
+     *
+     * @param [in] key of the best solution of the trajectory
+     * @param [in] best builds the best solution of the trajectory, only called when it is given to the incumbent
+     * @returns the solution to restart from, @b nullptr when the trajectory continues its search
+     */
+    std::unique_ptr<problem::Solution> exchange(const Key &key, const std::function<problem::Solution()> &best);
+
+    /** @brief the trajectory ended with @b solution */
+    void leave(const problem::Solution &solution, size_t trajectory);
+
+    /** @brief the trajectory ended without a solution */
+    void leave(size_t trajectory);
+
+    /** @brief the trajectories stop as soon as possible */
+    void cancel();
+
+    /** @brief the trajectories were cancelled */
+    const std::atomic<bool>& cancelled() const {return m_cancelled;}
+
+    /** @brief waits for at most @b time until all the trajectories ended
+     * @returns true when all the trajectories ended
+     */
+    bool wait_all(std::chrono::milliseconds time);
+
+    /** @brief the best solution a trajectory ended with, @b nullptr when there is none */
+    const problem::Solution* best() const;
+
+ private:
+    /** The worst trajectory restarts when the incumbent's objective is this fraction smaller than its objective */
+    static constexpr double restart_gap = 0.05;
+
+    /** @brief waits until the active trajectories arrive */
+    void wait_others(std::unique_lock<std::mutex> &lock);
+
+    /** @brief all the active trajectories arrived */
+    void next_generation();
+
+    /** @brief what the trajectories do after a meeting */
+    enum Role {kContinue, kGive, kRestart};
+
+    /** @brief decides the role of the trajectories that arrived */
+    void assign_roles();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    /** trajectories that did not end */
+    size_t m_active;
+
+    /** trajectories waiting on the current meeting */
+    size_t m_arrived {0};
+
+    /** counter of the meetings, the first and second part of a meeting are different generations */
+    size_t m_generation {0};
+
+    /** the current generation is the second part of a meeting */
+    bool m_second_part {false};
+
+    /** keys of the trajectories that arrived */
+    std::vector<Key> m_keys;
+
+    /** trajectory -> role after the meeting */
+    std::vector<Role> m_roles;
+
+    std::atomic<bool> m_cancelled {false};
+
+    /** the incumbent */
+    std::unique_ptr<problem::Solution> m_solution;
+    Key m_key {0, 0, 0};
+
+    /** trajectory -> the solution it ended with */
+    std::vector<std::unique_ptr<problem::Solution>> m_final;
+};
+
+/** @brief Tabu searches on several threads that share their best solution
+ *
+ * - Trajectory 0 is the single tabu search, the other ones insert the unassigned orders in a different order
+ *   and use longer tabu lists
+ * - The trajectories run on worker threads and evaluate their moves on their thread,
+ *   this thread checks for the postgres interruptions
+ * - The solution is the best solution of all the trajectories: it is not worse than the single tabu search
+ */
+class Multi_start : public problem::Solution {
+ public:
+    /** @brief Optimization operation */
+    Multi_start(const problem::Solution& solution, size_t times, bool stop_on_all_served, bool,
+            const Time_limit&, size_t threads);
+
+ private:
+    /** Time between the checks for the postgres interruptions */
+    static constexpr std::chrono::milliseconds check_period {10};
+};
+
+}  //  namespace tabu
+}  //  namespace optimizers
+}  //  namespace vrprouting
+
+#endif  // INCLUDE_OPTIMIZERS_MULTI_START_HPP_
@@ -0,0 +1,44 @@
+/*PGR-GNU*****************************************************************
+
+FILE: optimizers_code.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/*! @file */
+
+#ifndef INCLUDE_OPTIMIZERS_OPTIMIZERS_CODE_HPP_
+#define INCLUDE_OPTIMIZERS_OPTIMIZERS_CODE_HPP_
+#pragma once
+
+namespace vrprouting {
+namespace optimizers {
+
+/*! Optimizers that improve the initial solution */
+enum Optimizers_code {
+    TabuSearch,  /*! Tabu search: single pair insertions and swaps between routes */
+    Alns         /*! Adaptive Large Neighbourhood Search: ruin and recreate */
+};
+
+}  // namespace optimizers
+}  // namespace vrprouting
+
+#endif  // INCLUDE_OPTIMIZERS_OPTIMIZERS_CODE_HPP_
@@ -29,6 +29,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #define INCLUDE_OPTIMIZERS_SIMPLE_HPP_
 #pragma once
 
+#include "cpp_common/time_limit.hpp"
 #include "problem/solution.hpp"
 #include "problem/vehicle_pickDeliver.hpp"
 #include "initialsol/initials_code.hpp"
@@ -41,7 +42,8 @@ class Optimize : public problem::Solution {
     using Initials_code = initialsol::simple::Initials_code;
 
  public:
-    Optimize(const problem::Solution &solution, size_t times, const Initials_code&);
+    Optimize(const problem::Solution &solution, size_t times, const Initials_code&,
+            const Time_limit& = Time_limit());
 
     /* @brief decrease_truck
      *
@@ -81,6 +83,9 @@ class Optimize : public problem::Solution {
     void save_if_best();
 
     Initials_code m_kind;
+
+    /** When the time is over the best solution found so far is kept */
+    Time_limit m_time_limit;
 };
 
 }  //  namespace simple
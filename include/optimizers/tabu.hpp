@@ -29,13 +29,23 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #define INCLUDE_OPTIMIZERS_TABU_HPP_
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/parallel_for.hpp"
+#include "cpp_common/time_limit.hpp"
 #include "problem/solution.hpp"
 #include "optimizers/tabu_list.hpp"
+#include "optimizers/granular_lists.hpp"
 
 namespace vrprouting {
 namespace optimizers {
 namespace tabu {
 
+class Incumbent;
+
 /** @brief Class that optimizes a solution
  *
  * How to use:
@@ -51,15 +61,99 @@ namespace tabu {
 class Optimize : public problem::Solution {
  public:
     /** @brief Optimization operation */
-    Optimize(const problem::Solution& solution, size_t times, bool stop_on_all_served, bool);
+    Optimize(const problem::Solution& solution, size_t times, bool stop_on_all_served, bool,
+            const Time_limit& = Time_limit(), size_t threads = hardware_threads());
 
-    /** The best solution so far */
-    problem::Solution best_solution;
+    /** @brief Optimization operation of a trajectory of a multi-start search
+     *
+     * @warning the trajectory does not check for the postgres interruptions:
+     * it can run on a worker thread
+     */
+    Optimize(const problem::Solution& solution, size_t times, bool stop_on_all_served, bool,
+            const Time_limit&, size_t threads, size_t trajectory, Incumbent *incumbent);
 
  private:
+    /** @brief The best solution so far: the routes of the fleet's vehicles, in the fleet's order
+     *
+     * The other data of the solution does not change while optimizing,
+     * so the vehicles of the current fleet get the routes back
+     */
+    struct Best_solution {
+        /** id of the vehicle on each position of the fleet */
+        std::vector<int64_t> vehicle_ids;
+        /** route of the vehicle on each position of the fleet */
+        std::vector<problem::Vehicle_pickDeliver::Route> routes;
+        /** value of the objective function of the solution */
+        double objective;
+        /** number of orders on phony vehicles */
+        size_t unassigned;
+    };
+
+    /** The best solution so far */
+    Best_solution m_best;
+
+    /** @brief keeps the current solution as the best solution */
+    void save_best();
+
+    /** @brief the current solution becomes the best solution */
+    void restore_best();
+
+    /** @brief the routes of the current solution */
+    Best_solution snapshot() const;
+
+    /** @brief the current solution gets the routes of @b solution */
+    void restore(const Best_solution &solution);
+
+    /** Number of the trajectory on a multi-start search, 0 on a single search */
+    size_t m_trajectory {0};
+
+    /** Best solution shared by the trajectories of a multi-start search */
+    Incumbent *m_incumbent {nullptr};
+
+    /** Cycles between the exchanges with the incumbent */
+    static constexpr size_t exchange_cycles = 10;
+
+    /** @brief gives the best solution to the incumbent and restarts from the incumbent when asked */
+    void exchange();
+
+    /** @brief changes the order in which the unassigned orders are inserted, using the trajectory as seed */
+    void shuffle_unassigned();
+
+    /** @brief CHECK_FOR_INTERRUPTS when the search does not run on a worker thread */
+    void check_for_interrupts() const;
+
     /** Tabu lists of the problem */
     TabuList tabu_list;
 
+    /** Number of vehicles on the granular list of an order */
+    static constexpr size_t granular_vehicles = 16;
+
+    /** Problems with this number of orders or more use granular lists */
+    static constexpr size_t granular_min_orders = 1000;
+
+    /** For each order, the vehicles near it: the moves only consider those vehicles */
+    Granular_lists m_granular {granular_vehicles};
+
+    /** the problem is big enough to use the granular lists */
+    bool m_use_granular {false};
+
+    /** Problems with this number of orders or more improve the routes changed by a move
+     *
+     * Below granular_min_orders: the intra-route moves can be checked on problems without granular lists
+     */
+    static constexpr size_t intra_route_min_orders = 500;
+
+    /** the problem is big enough to improve the routes changed by a move */
+    bool m_use_intra_route {false};
+
+    /** @brief moves the nodes inside the routes changed by a move */
+    void improve_routes(problem::Vehicle_pickDeliver&, problem::Vehicle_pickDeliver&);
+
+    /** @brief is @b vehicle on the granular list of the order? */
+    bool is_near(const problem::Vehicle_pickDeliver &vehicle, size_t o_id) const {
+        return !m_use_granular || m_granular.near_orders(vehicle).test(o_id);
+    }
+
     /** @brief Main optimization controller */
     void tabu_search();
 
@@ -80,6 +174,125 @@ class Optimize : public problem::Solution {
     /** @brief Swapping pairs Between Routes: initiate directed or undirected swaps of orders between vehicles. */
     bool swap_between_routes(bool intensify, bool diversify);
 
+    /** @brief Result of hillClimb(order) on a route */
+    struct Insertion_result {
+        /** the route has the order */
+        bool inserted;
+        bool feasible;
+        TInterval travel_time;
+        double objective;
+    };
+
+    /** @brief Result of erase(order) on a route */
+    struct Removal_result {
+        /** the route does not have the order and is feasible */
+        bool feasible;
+        bool empty;
+        TInterval travel_time;
+        /** fingerprint of the route without the order */
+        uint64_t path_hash;
+    };
+
+    /** @brief Results of the evaluations done on a route
+     *
+     * The results are valid while the route does not change:
+     * a move only changes two routes, the results of the other routes are used on the next iterations.
+     */
+    struct Route_memo {
+        /** order -> insertion of the order */
+        std::unordered_map<size_t, Insertion_result> insertion;
+        /** order -> removal of the order */
+        std::unordered_map<size_t, Removal_result> removal;
+        /** exchange_key(removed, inserted) -> insertion of an order after removing another one */
+        std::unordered_map<size_t, Insertion_result> exchange;
+    };
+
+    /** @brief A single pair insertion candidate: move the order @b o_id from vehicle @b from to vehicle @b to */
+    struct Insertion_candidate {
+        size_t from;
+        size_t to;
+        size_t o_id;
+        uint64_t candidate;
+        /** the results below are valid */
+        bool evaluated;
+        /** the order on the "to" vehicle */
+        Insertion_result insertion;
+        /** the "from" vehicle without the order: valid when the order was inserted */
+        Removal_result removal;
+        /** the result was not found on the memo */
+        bool new_insertion;
+        bool new_removal;
+    };
+
+    /** @brief A swap candidate: exchange the order @b o_id1 of vehicle @b from with the order @b o_id2 of vehicle @b to */
+    struct Swap_candidate {
+        size_t from;
+        size_t to;
+        size_t o_id1;
+        size_t o_id2;
+        uint64_t candidate1;
+        uint64_t candidate2;
+        /** the "to" vehicle without @b o_id2: candidate1 is valid when feasible */
+        Removal_result to_removal;
+        /** the "from" vehicle without @b o_id1: candidate2 is valid when feasible */
+        Removal_result from_removal;
+        /** the insertions were evaluated: the results below are valid */
+        bool evaluated;
+        /** @b o_id1 on the "to" vehicle without @b o_id2 */
+        Insertion_result to_insertion;
+        /** @b o_id2 on the "from" vehicle without @b o_id1: valid when @b o_id1 was inserted */
+        Insertion_result from_insertion;
+        /** the result was not found on the memo */
+        bool new_to_removal;
+        bool new_from_removal;
+        bool new_to_insertion;
+        bool new_from_insertion;
+    };
+
+    /** Minimum number of candidates evaluated by a thread: smaller neighbourhoods are evaluated on this thread */
+    static constexpr size_t candidates_per_thread = 64;
+
+    /** Maximum number of threads that evaluate a neighbourhood */
+    size_t m_threads;
+
+    /** @brief Evaluates the candidates of a neighbourhood using several threads */
+    template <typename Candidate>
+    void evaluate_in_parallel(std::vector<Candidate>&, bool diversify);
+
+    /** @brief Does the insertion on copies of the vehicles and keeps the results */
+    void evaluate(Insertion_candidate&, bool diversify, bool skip_infeasible) const;
+
+    /** @brief Does the swap on copies of the vehicles and keeps the results */
+    void evaluate(Swap_candidate&, bool diversify, bool skip_infeasible) const;
+
+    /** @brief Keeps on the memo the results that were not found on it */
+    void remember(const Insertion_candidate&);
+
+    /** @brief Keeps on the memo the results that were not found on it */
+    void remember(const Swap_candidate&);
+
+    /** @brief Forgets the results of the routes that changed */
+    void refresh_route_memo();
+
+    /** @brief key of the memo of a route: the vehicle and its route */
+    static uint64_t memo_key(const problem::Vehicle_pickDeliver &vehicle) {return vehicle.route_hash();}
+
+    /** @brief key of the exchange of orders on Route_memo */
+    size_t exchange_key(size_t removed, size_t inserted) const {return removed * orders().size() + inserted;}
+
+    /** @brief hillClimb(order) on a copy of the vehicle */
+    static Insertion_result insert_order(const problem::Vehicle_pickDeliver&, const problem::Order&);
+
+    /** @brief erase(order) on a copy of the vehicle */
+    static Removal_result erase_order(const problem::Vehicle_pickDeliver&, const problem::Order&);
+
+    /** @brief erase(removed) then hillClimb(inserted) on a copy of the vehicle */
+    static Insertion_result exchange_orders(
+            const problem::Vehicle_pickDeliver&, const problem::Order &removed, const problem::Order &inserted);
+
+    /** Results of the evaluations of the real vehicles' routes: memo_key(vehicle) -> memo */
+    std::unordered_map<uint64_t, Route_memo> m_route_memo;
+
     /** @brief save a new found solution only if it is best */
     void save_if_best();
 
@@ -92,6 +305,9 @@ class Optimize : public problem::Solution {
     /** Flag to just build a solution and not optimize it */
     bool m_optimize;
 
+    /** When the time is over the best solution found so far is kept */
+    Time_limit m_time_limit;
+
     /** Limit for a cycle */
     size_t m_standard_limit = 30;
 
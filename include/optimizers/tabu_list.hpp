@@ -29,11 +29,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #define INCLUDE_OPTIMIZERS_TABU_LIST_HPP_
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
-#include <string>
 #include <deque>
-#include <set>
+#include <unordered_set>
 
+#include "cpp_common/fingerprint_set.hpp"
 #include "optimizers/move.hpp"
 
 namespace vrprouting {
@@ -50,6 +53,28 @@ class TabuList {
     /** iterator type that does not allows modification */
     typedef std::deque<Move>::const_iterator const_iterator;
 
+    /** default maximum number of candidates on the infeasible list */
+    static constexpr size_t default_infeasible_capacity = size_t(1) << 18;
+
+    /** default maximum number of candidates on the seen list */
+    static constexpr size_t default_seen_capacity = size_t(1) << 16;
+
+    /** largest capacity of the infeasible and seen lists: 32 MB each */
+    static constexpr size_t max_capacity = size_t(1) << 22;
+
+    /** @brief tabu list with bounded infeasible and seen lists
+     *
+     * @param [in] infeasible_capacity maximum number of candidates on the infeasible list
+     * @param [in] seen_capacity maximum number of candidates on the seen list
+     *
+     * Capacities above max_capacity are reduced to max_capacity
+     */
+    explicit TabuList(
+            size_t infeasible_capacity = default_infeasible_capacity,
+            size_t seen_capacity = default_seen_capacity) :
+        m_infeasible_list(std::min(infeasible_capacity, max_capacity)),
+        m_seen_list(std::min(seen_capacity, max_capacity)) {}
+
     /** @brief Make a move "tabu" by adding it to the tabu list */
     void add(const Move &m);
 
@@ -88,33 +113,74 @@ class TabuList {
     /** Constant iteratori pointing to the last element of the tabu list */
     const_iterator end() const {return m_tabu_list.end();}
 
+    /** @brief fingerprint of the candidate: inserting the order on the vehicle's path */
+    static uint64_t candidate(const problem::Vehicle_pickDeliver&, size_t order_idx);
+
+    /** @brief fingerprint of the candidate: inserting the order on a path with the given fingerprint */
+    static uint64_t candidate(uint64_t path_hash, size_t order_idx) {
+        return hash_combine(path_hash, order_idx);
+    }
+
     /** @brief Checks to see if a move candidate is infeasible (in the infeasible list) */
-    bool has_infeasible(const std::string& candidate);
+    bool has_infeasible(uint64_t candidate) const;
 
     /** @brief Adds a move candidate to the infeasible list */
-    void add_infeasible(const std::string& candidate);
+    void add_infeasible(uint64_t candidate);
 
     /** @brief Checks to see if a move candidate has already been done before (in the seen list) */
-    bool has_seen(const std::string& candidate);
+    bool has_seen(uint64_t candidate) const;
 
     /** @brief Adds a move candidate to the seen list */
-    void add_seen(const std::string& candidate);
+    void add_seen(uint64_t candidate);
 
  private:
+    /** @brief The attributes that identify a move: the ones compared by operator==(const Move&, const Move&) */
+    struct Key {
+        int64_t vid1;
+        int64_t vid2;
+        int64_t oid1;
+        int64_t oid2;
+        bool is_swap;
+
+        bool operator==(const Key &rhs) const {
+            return vid1 == rhs.vid1 && vid2 == rhs.vid2
+                && oid1 == rhs.oid1 && oid2 == rhs.oid2
+                && is_swap == rhs.is_swap;
+        }
+    };
+
+    struct Key_hash {
+        size_t operator()(const Key &k) const {
+            auto h = hash_combine(static_cast<uint64_t>(k.vid1), static_cast<uint64_t>(k.vid2));
+            h = hash_combine(h, static_cast<uint64_t>(k.oid1));
+            h = hash_combine(h, static_cast<uint64_t>(k.oid2));
+            return static_cast<size_t>(hash_combine(h, k.is_swap));
+        }
+    };
+
+    /** @brief the key of the move */
+    static Key key(const Move &m) {return {m.vid1(), m.vid2(), m.oid1(), m.oid2(), m.is_swap()};}
+
     /** @brief Checks to see if a (general) move is "tabu" (in the tabu list) */
-    bool has(const Move &) const;
+    bool has(const Key &) const;
 
     /** the maximum length (tabu_length) of the tabu list */
-    size_t m_max_length;
+    size_t m_max_length {0};
 
-    /** the tabu list */
+    /** the tabu list, in the order the moves were added */
     std::deque<Move> m_tabu_list;
 
-    /** the infeasible list */
-    std::set<std::string> m_infeasible_list;
+    /** keys of the moves on the tabu list: the look up does not scan the list */
+    std::unordered_set<Key, Key_hash> m_tabu_keys;
+
+    /** the infeasible list
+     *
+     * Bounded: a forgotten candidate is evaluated again and found infeasible again
+     */
+    Fingerprint_set m_infeasible_list;
 
     /** the seen list */
-    std::set<std::string> m_seen_list;
+    Fingerprint_set m_seen_list;
 };
 
 
@@ -40,7 +40,9 @@ class Messages;
 class Short_vehicle;
 
 namespace problem {
+class Matrix;
 class Orders;
+class Reachability;
 class Vehicle_node;
 
 class Fleet: protected std::vector<Vehicle_pickDeliver> {
@@ -55,6 +57,7 @@ class Fleet: protected std::vector<Vehicle_pickDeliver> {
     Fleet(
         const std::vector<Vehicle_t>&,
         const Orders&,
+        const Matrix&,
         std::vector<Vehicle_node>&, size_t&);
 
     /** @brief Create a fleet based on the Vehicles of the problem */
@@ -62,6 +65,7 @@ class Fleet: protected std::vector<Vehicle_pickDeliver> {
         const std::vector<Vehicle_t>&,
         const std::vector<Short_vehicle>&,
         const Orders&,
+        const Matrix&,
         std::vector<Vehicle_node>&,
         size_t&);
 
@@ -103,6 +107,9 @@ class Fleet: protected std::vector<Vehicle_pickDeliver> {
     /** @brief sets the compatability of orders on the fleet */
     void set_compatibles(const Orders &orders);
 
+    /** @brief sets on the vehicles the "can follow" matrices of their speed */
+    void set_reachability(const std::vector<Reachability> &reachability);
+
     bool is_fleet_ok() const;
 
     bool is_order_ok(const Order &order) const;
@@ -117,6 +124,7 @@ class Fleet: protected std::vector<Vehicle_pickDeliver> {
     void add_vehicle(
         const Vehicle_t&, const std::vector<Short_vehicle>&,
         const Orders&,
+        const Matrix&,
         std::vector<Vehicle_node>& p_nodes, size_t& node_id);
 
     /** @brief build the fleet */
@@ -124,6 +132,7 @@ class Fleet: protected std::vector<Vehicle_pickDeliver> {
         std::vector<Vehicle_t>,
         const std::vector<Short_vehicle>&,
         const Orders&,
+        const Matrix&,
         std::vector<Vehicle_node>&, size_t&);
 
     void invariant() const;
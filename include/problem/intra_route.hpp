@@ -0,0 +1,329 @@
+/*PGR-GNU*****************************************************************
+
+FILE: intra_route.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_PROBLEM_INTRA_ROUTE_HPP_
+#define INCLUDE_PROBLEM_INTRA_ROUTE_HPP_
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/assert.hpp"
+#include "problem/travel_time_policy.hpp"
+#include "problem/vehicle_node.hpp"
+
+namespace vrprouting {
+namespace problem {
+
+/** @class Intra_route
+ * @brief Moves of nodes inside a route
+ *
+ * - relocate: moves a node to another position
+ * - or-opt: moves 2 or 3 consecutive nodes to another position
+ * - exchange: swaps the positions of two nodes
+ *
+ * A pickup is always visited before its delivery, and only the nodes of movable orders are moved.
+ *
+ * Each move is evaluated in constant time by concatenating segments of the route:
+ * the segments of the start of the route and of the end of the route are computed once,
+ * the segments in between grow one node at a time.
+ *
+ * @tparam Travel a Travel_time<Static_matrix<Cells>, Speed_policy> from travel_time_policy.hpp
+ *
+ * @pre The matrix is not time dependant: the travel times do not depend on the departure time
+ * @pre The vehicle does not accept violations: the user's solution had no violations
+ */
+template <typename Travel>
+class Intra_route {
+    /** @brief Sequence of nodes of a route
+     *
+     * When the vehicle arrives at the first node at time @b t <= @b latest,
+     * it departs from the last node at max(t, earliest) + duration
+     */
+    struct Segment {
+        /** matrix index of the first node */
+        Idx first;
+        /** matrix index of the last node */
+        Idx last;
+        TTimestamp earliest;
+        TInterval duration;
+        /** latest arrival at the first node that visits all the nodes on time */
+        TTimestamp latest;
+        /** there is an arrival time that visits all the nodes on time */
+        bool feasible;
+        /** travel time between the nodes of the segment */
+        TInterval travel_time;
+        /** cargo change after the segment */
+        Amount load;
+        /** highest cargo change inside the segment */
+        Amount max_load;
+        /** lowest cargo change inside the segment */
+        Amount min_load;
+    };
+
+    /** @brief kind of move */
+    enum Kind {kNone, kForward, kBackward, kExchange};
+
+    /** @brief Description of a move on the current route */
+    struct Move {
+        Kind kind;
+        /** first node moved */
+        size_t p;
+        /** number of nodes moved (kForward, kBackward) or second node moved (kExchange) */
+        size_t len;
+        /** kForward: the nodes go after q, kBackward: the nodes go before q */
+        size_t q;
+    };
+
+ public:
+    /** @brief Route made with the evaluated nodes [first, last)
+     *
+     * @param [in] first, last the nodes of the route
+     * @param [in] movable movable[i] is true when the i-th node can be moved
+     * @param [in] capacity of the vehicle
+     * @param [in] speed of the vehicle
+     */
+    template <typename Iterator>
+    Intra_route(Iterator first, Iterator last, const std::vector<bool> &movable, PAmount capacity, Speed speed) :
+        m_matrix(first->time_matrix()),
+        m_movable(movable),
+        m_capacity(capacity),
+        m_speed(speed),
+        m_start_time(first->opens()) {
+        auto n = static_cast<size_t>(std::distance(first, last));
+        pgassert(m_movable.size() == n);
+        m_node.reserve(n);
+        m_partner.assign(n, n);
+        m_is_pickup.reserve(n);
+
+        std::unordered_map<int64_t, size_t> pickups;
+        size_t i = 0;
+        for (auto node = first; node != last; ++node, ++i) {
+            m_node.push_back({node->matrix_idx(), node->matrix_idx(),
+                    node->opens(), node->service_time(), node->closes(), true,
+                    0, node->demand(), node->demand(), node->demand()});
+            m_is_pickup.push_back(node->is_pickup());
+            if (node->is_pickup()) pickups[node->order()] = i;
+            if (node->is_delivery()) {
+                auto pick = pickups.find(node->order());
+                if (pick != pickups.end()) {
+                    m_partner[i] = pick->second;
+                    m_partner[pick->second] = i;
+                }
+            }
+        }
+
+        m_prefix.resize(n);
+        m_suffix.resize(n);
+        m_prefix[0] = m_node[0];
+        for (i = 1; i < n; ++i) m_prefix[i] = concat(m_prefix[i - 1], m_node[i]);
+        m_suffix[n - 1] = m_node[n - 1];
+        for (i = n - 1; i-- > 0; ) m_suffix[i] = concat(m_node[i], m_suffix[i + 1]);
+    }
+
+    /** @brief number of nodes on the route */
+    size_t size() const {return m_node.size();}
+
+    /** @brief travel time of the route */
+    TInterval travel_time() const {return m_prefix.back().travel_time;}
+
+    /** @brief Best move that reduces the travel time of the route
+     *
+     * @param [out] sequence positions of the current nodes in the order of the new route
+     * @returns true when a move reduces the travel time
+     *
+     * The first move found with the smallest travel time is kept.
+     */
+    bool best_move(std::vector<size_t> &sequence) const {
+        auto n = size();
+        Move best {kNone, 0, 0, 0};
+        auto best_travel_time = travel_time();
+
+        for (size_t len = 1; len <= max_segment && len + 2 <= n; ++len) {
+            for (size_t p = 1; p + len < n; ++p) {
+                segment_moves(p, len, best, best_travel_time);
+            }
+        }
+        for (size_t p = 1; p + 2 < n; ++p) exchanges(p, best, best_travel_time);
+
+        if (best.kind == kNone) return false;
+        sequence = apply(best);
+        return true;
+    }
+
+ private:
+    /** longest sequence of nodes moved by or-opt */
+    static constexpr size_t max_segment = 3;
+
+    /** @brief the vehicle goes from the last node of @b a to the first node of @b b */
+    Segment concat(const Segment &a, const Segment &b) const {
+        auto arc = Travel::by_index(m_matrix, a.last, b.first, 0, m_speed);
+        auto bound = b.latest - a.duration - arc;
+        return {
+            a.first, b.last,
+            std::max(a.earliest, b.earliest - a.duration - arc),
+            a.duration + arc + b.duration,
+            std::min(a.latest, bound),
+            a.feasible && b.feasible && a.earliest <= bound,
+            a.travel_time + arc + b.travel_time,
+            a.load + b.load,
+            std::max(a.max_load, a.load + b.max_load),
+            std::min(a.min_load, a.load + b.min_load)};
+    }
+
+    /** @brief is the complete route @b r feasible? */
+    bool is_feasible(const Segment &r) const {
+        return r.feasible && m_start_time <= r.latest
+            && r.load == 0 && r.min_load >= 0 && r.max_load <= static_cast<Amount>(m_capacity);
+    }
+
+    /** @brief keeps @b move when route @b r is feasible and shorter than the best so far */
+    void consider(const Segment &r, const Move &move, Move &best, TInterval &best_travel_time) const {
+        if (r.travel_time < best_travel_time && is_feasible(r)) {
+            best = move;
+            best_travel_time = r.travel_time;
+        }
+    }
+
+    /** @brief moves the nodes [p, p + len) forward and backward */
+    void segment_moves(size_t p, size_t len, Move &best, TInterval &best_travel_time) const {
+        auto n = size();
+        auto last = p + len - 1;
+
+        /* precedence: pickups stay before their deliveries and deliveries after their pickups */
+        auto forward_limit = n - 2;
+        size_t backward_limit = 1;
+        auto segment = m_node[p];
+        for (auto i = p; i <= last; ++i) {
+            if (!m_movable[i]) return;
+            if (i > p) segment = concat(segment, m_node[i]);
+            auto partner = m_partner[i];
+            if (partner >= p && partner <= last) continue;
+            if (m_is_pickup[i]) {
+                forward_limit = std::min(forward_limit, partner - 1);
+            } else if (partner < n) {
+                backward_limit = std::max(backward_limit, partner + 1);
+            }
+        }
+
+        /* the nodes go after q */
+        if (last + 1 <= forward_limit) {
+            auto middle = m_node[last + 1];
+            for (auto q = last + 1; q <= forward_limit; ++q) {
+                if (q > last + 1) middle = concat(middle, m_node[q]);
+                consider(concat(concat(concat(m_prefix[p - 1], middle), segment), m_suffix[q + 1]),
+                        {kForward, p, len, q}, best, best_travel_time);
+            }
+        }
+
+        /* the nodes go before q */
+        if (p >= 2 && p - 1 >= backward_limit) {
+            auto middle = m_node[p - 1];
+            for (auto q = p - 1; q >= backward_limit; --q) {
+                if (q < p - 1) middle = concat(m_node[q], middle);
+                consider(concat(concat(concat(m_prefix[q - 1], segment), middle), m_suffix[last + 1]),
+                        {kBackward, p, len, q}, best, best_travel_time);
+            }
+        }
+    }
+
+    /** @brief swaps the node @b i with the nodes after it */
+    void exchanges(size_t i, Move &best, TInterval &best_travel_time) const {
+        auto n = size();
+        if (!m_movable[i]) return;
+
+        /* a pickup can not go after its delivery */
+        auto j_limit = m_is_pickup[i] ? std::min(m_partner[i] - 1, n - 2) : n - 2;
+        Segment middle {};
+        for (auto j = i + 1; j <= j_limit; ++j) {
+            if (j > i + 1) middle = j == i + 2 ? m_node[i + 1] : concat(middle, m_node[j - 1]);
+            if (!m_movable[j]) continue;
+            /* a delivery can not go before its pickup */
+            if (!m_is_pickup[j] && m_partner[j] >= i) continue;
+
+            auto r = concat(m_prefix[i - 1], m_node[j]);
+            if (j > i + 1) r = concat(r, middle);
+            r = concat(concat(r, m_node[i]), m_suffix[j + 1]);
+            consider(r, {kExchange, i, j, 0}, best, best_travel_time);
+        }
+    }
+
+    /** @brief positions of the current nodes in the order of the route after the move */
+    std::vector<size_t> apply(const Move &move) const {
+        auto n = size();
+        std::vector<size_t> sequence(n);
+        for (size_t i = 0; i < n; ++i) sequence[i] = i;
+
+        auto first = sequence.begin();
+        auto p = static_cast<std::ptrdiff_t>(move.p);
+        auto len = static_cast<std::ptrdiff_t>(move.len);
+        auto q = static_cast<std::ptrdiff_t>(move.q);
+        switch (move.kind) {
+            case kForward:
+                std::rotate(first + p, first + p + len, first + q + 1);
+                break;
+            case kBackward:
+                std::rotate(first + q, first + p, first + p + len);
+                break;
+            case kExchange:
+                std::swap(sequence[move.p], sequence[move.len]);
+                break;
+            case kNone:
+                break;
+        }
+        return sequence;
+    }
+
+    const Matrix &m_matrix;
+    const std::vector<bool> &m_movable;
+    PAmount m_capacity;
+    Speed m_speed;
+
+    /** arrival time at the starting site */
+    TTimestamp m_start_time;
+
+    /** the nodes as segments */
+    std::vector<Segment> m_node;
+
+    /** m_prefix[i] is the segment [0, i] */
+    std::vector<Segment> m_prefix;
+
+    /** m_suffix[i] is the segment [i, size()) */
+    std::vector<Segment> m_suffix;
+
+    /** position of the other node of the order, size() for the starting and ending sites */
+    std::vector<size_t> m_partner;
+
+    std::vector<bool> m_is_pickup;
+};
+
+}  // namespace problem
+}  // namespace vrprouting
+
+#endif  // INCLUDE_PROBLEM_INTRA_ROUTE_HPP_
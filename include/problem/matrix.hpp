@@ -64,6 +64,15 @@ class Matrix : public base::Base_Matrix {
     /** @brief retrun the travel time times from the matrix*/
     TInterval travel_time(Id, Id) const;
 
+    /** @brief retrun the travel time using the matrix indices of the nodes */
+    TInterval travel_time_by_index(Idx, Idx, TTimestamp) const;
+
+    /** @brief retrun the travel time adjusted with the time dependant multipliers using the matrix indices */
+    TInterval time_dependent_travel_time(Idx, Idx, TTimestamp) const;
+
+    /** @brief true when the travel times depend on the time of departure */
+    bool is_time_dependent() const {return m_multipliers.size() != 1;}
+
     std::string multipliers_str() const;
 
  private:
@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #pragma once
 
 
+#include "cpp_common/dynamic_bitset.hpp"
 #include "cpp_common/identifier.hpp"
 #include "cpp_common/identifiers.hpp"
 #include "problem/vehicle_node.hpp"
@@ -64,11 +65,20 @@ class Order : public Identifier {
     /** @brief Get a subset of the orders that can be placed before @b this order */
     Identifiers<size_t> subsetI(const Identifiers<size_t> &I) const;
 
+    /** @brief The orders that can be placed after @b this order */
+    const Dynamic_bitset& compatibleJ() const {return m_compatibleJ;}
+
+    /** @brief The orders that can be placed before @b this order */
+    const Dynamic_bitset& compatibleI() const {return m_compatibleI;}
+
     /** @} */
 
     /** @brief set compatability of @b this orther with the other order */
     void set_compatibles(const Order&, Speed speed = 1.0);
 
+    /** @brief sets the number of orders the compatibility can hold */
+    void reserve_compatibles(size_t);
+
     /** @brief is the order valid? */
     bool is_valid(Speed speed = 1.0) const;
 
@@ -85,8 +95,10 @@ class Order : public Identifier {
      this -> "{J}";
      }
      @enddot
+     *
+     * bit o is set when the o-th order is compatible
      */
-    Identifiers<size_t> m_compatibleJ;
+    Dynamic_bitset m_compatibleJ;
 
     /** Storage for the orders that can be placed before @b this order
      *
@@ -97,8 +109,10 @@ class Order : public Identifier {
      "{I}" -> this;
      }
      @enddot
+     *
+     * bit o is set when the o-th order is compatible
      */
-    Identifiers<size_t> m_compatibleI;
+    Dynamic_bitset m_compatibleI;
 
     /** The pick up node identifier
      *
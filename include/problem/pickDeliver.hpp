@@ -35,6 +35,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "cpp_common/messages.hpp"
 #include "problem/orders.hpp"
 #include "problem/fleet.hpp"
+#include "problem/reachability.hpp"
 
 using CompatibleVehicles_rt = struct CompatibleVehicles_rt;
 
@@ -87,6 +88,12 @@ class PickDeliver {
     void add_node(const Vehicle_node &node) {m_nodes.push_back(node);}
 
  private:
+    /** @brief computes the "can follow" matrices and gives them to the vehicles */
+    void set_reachability();
+
+    /** maximum number of bits used by all the "can follow" matrices */
+    static constexpr size_t max_reachability_bits = size_t(1) << 27;
+
     /** used to keep track of the next index the node gets
      *
      * The first one will get 0
@@ -102,6 +109,12 @@ class PickDeliver {
      */
     std::vector<Vehicle_node> m_nodes { };
 
+    /** "can follow" matrices of the nodes, one per speed
+     *
+     * The vehicles point to them: reserved before being filled
+     */
+    std::vector<Reachability> m_reachability { };
+
  protected:
     /** the set of orders */
     Orders m_orders;
@@ -0,0 +1,82 @@
+/*PGR-GNU*****************************************************************
+
+FILE: reachability.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_PROBLEM_REACHABILITY_HPP_
+#define INCLUDE_PROBLEM_REACHABILITY_HPP_
+#pragma once
+
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/dynamic_bitset.hpp"
+#include "problem/tw_node.hpp"
+
+namespace vrprouting {
+namespace problem {
+
+class Vehicle_node;
+
+/** @class Reachability
+ * @brief Node x node "can follow" matrix of a problem for one speed
+ *
+ * Bit (I, J) is set when J.is_compatible_IJ(I, speed):
+ * the node J can be visited after the node I without a time window violation on J
+ *
+ * - Rows are indexed by the idx of node I and columns by the idx of node J
+ * - Each row starts on a new word of the bitset
+ */
+class Reachability {
+ public:
+    /** @brief computes the matrix of the nodes for the speed */
+    Reachability(const std::vector<Vehicle_node> &nodes, Speed speed);
+
+    /** @brief the speed used to build the matrix */
+    Speed speed() const {return m_speed;}
+
+    /** @brief number of bits used by a matrix of @b n nodes */
+    static size_t bits(size_t n) {
+        return n * row_bits(n);
+    }
+
+    /** @brief Can @b J be visited after @b I? same as J.is_compatible_IJ(I, speed()) */
+    bool can_follow(const Tw_node &I, const Tw_node &J) const {
+        return m_bits.test(I.idx() * m_row_bits + J.idx());
+    }
+
+ private:
+    /** @brief row length: rounded to complete words */
+    static size_t row_bits(size_t n) {
+        return ((n + Dynamic_bitset::word_bits - 1) / Dynamic_bitset::word_bits) * Dynamic_bitset::word_bits;
+    }
+
+    Speed m_speed;
+    size_t m_row_bits;
+    Dynamic_bitset m_bits;
+};
+
+}  // namespace problem
+}  // namespace vrprouting
+
+#endif  // INCLUDE_PROBLEM_REACHABILITY_HPP_
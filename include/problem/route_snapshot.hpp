@@ -0,0 +1,313 @@
+/*PGR-GNU*****************************************************************
+
+FILE: route_snapshot.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_PROBLEM_ROUTE_SNAPSHOT_HPP_
+#define INCLUDE_PROBLEM_ROUTE_SNAPSHOT_HPP_
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "c_types/typedefs.h"
+#include "cpp_common/assert.hpp"
+#include "problem/travel_time_policy.hpp"
+#include "problem/vehicle_node.hpp"
+
+namespace vrprouting {
+namespace problem {
+
+/** @brief Positions where the pickup and the delivery of an order are inserted */
+struct Insertion_positions {
+    bool found;
+    size_t pick_pos;
+    size_t drop_pos;
+};
+
+/** @class Route_snapshot
+ * @brief Evaluated route stored as one array per attribute
+ *
+ * Evaluates the insertion of a pickup & delivery pair on all the candidate positions
+ * without modifying the route.
+ *
+ * - Nodes before the pickup keep their schedule
+ * - Nodes between the pickup and the delivery are re-scheduled
+ * - Nodes after the delivery are checked with the latest arrival time that keeps them on time
+ *
+ * The result is the same as inserting the pair on every position and evaluating the route.
+ *
+ * @tparam Travel a Travel_time<Static_matrix<Cells>, Speed_policy> from travel_time_policy.hpp
+ *
+ * @pre The matrix is not time dependant: the travel times do not depend on the departure time
+ * @pre The vehicle does not accept violations: the user's solution had no violations
+ */
+template <typename Travel>
+class Route_snapshot {
+ public:
+    /** @brief Takes the snapshot of the evaluated nodes [first, last) */
+    template <typename Iterator>
+    Route_snapshot(Iterator first, Iterator last, PAmount capacity, Speed speed) :
+        m_matrix(first->time_matrix()),
+        m_capacity(capacity),
+        m_speed(speed) {
+        auto n = static_cast<size_t>(std::distance(first, last));
+        m_matrix_idx.reserve(n);
+        m_opens.reserve(n);
+        m_closes.reserve(n);
+        m_service.reserve(n);
+        m_departure.reserve(n);
+        m_tot_travel.reserve(n);
+        m_cargo.reserve(n);
+        m_twvTot.reserve(n);
+        m_cvTot.reserve(n);
+        m_is_pickup.reserve(n);
+
+        for (auto node = first; node != last; ++node) {
+            m_matrix_idx.push_back(node->matrix_idx());
+            m_opens.push_back(node->opens());
+            m_closes.push_back(node->closes());
+            m_service.push_back(node->service_time());
+            m_departure.push_back(node->departure_time());
+            m_tot_travel.push_back(node->total_travel_time());
+            m_cargo.push_back(node->cargo());
+            m_twvTot.push_back(node->twvTot());
+            m_cvTot.push_back(node->cvTot());
+            m_is_pickup.push_back(node->is_pickup());
+        }
+        set_latest_arrival();
+    }
+
+    /** @brief number of nodes on the route */
+    size_t size() const {return m_matrix_idx.size();}
+
+    /** @brief Best position to insert the pair: as Vehicle_pickDeliver::hillClimb does
+     *
+     * @param [in] pick, drop the nodes of the order
+     * @param [in] pick_pos range of positions for the pickup on the new route
+     * @param [in] drop_pos range of positions for the delivery on the new route
+     * @param [in] count_travel_time when false all insertions have the same objective
+     *
+     * Positions are visited in increasing order of pickup, then of delivery,
+     * the first position with the smallest objective is kept.
+     */
+    Insertion_positions best_insertion(
+            const Tw_node &pick, const Tw_node &drop,
+            std::pair<size_t, size_t> pick_pos,
+            std::pair<size_t, size_t> drop_pos,
+            bool count_travel_time) const {
+        pgassert(pick.demand() + drop.demand() == 0);
+        pgassert(pick_pos.first > 0);
+        pgassert(drop_pos.second < size() + 1);
+
+        Insertion_positions best {false, 0, 0};
+        auto n = size();
+        auto total = m_tot_travel.back();
+        auto min_delta_objective = (std::numeric_limits<double>::max)();
+
+        auto to_pick = travel_times_to(pick);
+        auto from_pick = travel_times_from(pick);
+        auto to_drop = travel_times_to(drop);
+        auto from_drop = travel_times_from(drop);
+        auto pick_to_drop = Travel::by_index(m_matrix, pick.matrix_idx(), drop.matrix_idx(), 0, m_speed);
+
+        for (auto p = pick_pos.first; p <= pick_pos.second && p < n; ++p) {
+            auto prev = p - 1;
+            /* violations before the pickup stay */
+            if (m_twvTot[prev] != 0 || m_cvTot[prev] != 0) break;
+
+            auto pick_arrival = m_departure[prev] + to_pick[prev];
+            if (pick.is_late_arrival(pick_arrival)) continue;
+            auto pick_cargo = m_cargo[prev] + pick.demand();
+            if (!in_capacity(pick_cargo)) continue;
+
+            /* the last node before the delivery: starts being the pickup */
+            auto last_departure = std::max(pick_arrival, pick.opens()) + pick.service_time();
+            auto last_cargo = pick_cargo;
+            auto last_to_drop = pick_to_drop;
+            auto travel = m_tot_travel[prev] + to_pick[prev];
+            auto k = p;
+
+            for (auto d = std::max(drop_pos.first, p + 1); d <= drop_pos.second; ++d) {
+                /* re-schedule the nodes in between: the route is P r[p] ... r[d - 2] D */
+                bool in_between_ok = true;
+                for (; k + 1 < d; ++k) {
+                    auto arc = k == p ? from_pick[k] : m_tot_travel[k] - m_tot_travel[k - 1];
+                    auto arrival = last_departure + arc;
+                    last_cargo = m_cargo[k] + pick.demand();
+                    if (arrival > m_closes[k] || !in_capacity(last_cargo)) {
+                        in_between_ok = false;
+                        break;
+                    }
+                    last_departure = std::max(arrival, m_opens[k]) + m_service[k];
+                    last_to_drop = to_drop[k];
+                    travel += arc;
+                }
+                /* later positions keep the node that failed in between */
+                if (!in_between_ok) break;
+
+                auto drop_arrival = last_departure + last_to_drop;
+                if (drop.is_late_arrival(drop_arrival)) continue;
+                if (!in_capacity(last_cargo + drop.demand())) continue;
+
+                /* the nodes after the delivery */
+                auto next = d - 1;
+                auto drop_departure = std::max(drop_arrival, drop.opens()) + drop.service_time();
+                if (m_cvTot.back() != m_cvTot[next - 1]) continue;
+                if (m_latest[next] == no_arrival || drop_departure + from_drop[next] > m_latest[next]) continue;
+
+                auto new_total = travel + last_to_drop + from_drop[next] + (total - m_tot_travel[next]);
+                auto delta_objective = count_travel_time ?
+                    static_cast<double>(new_total) - static_cast<double>(total) :
+                    0.0;
+                if (delta_objective < min_delta_objective) {
+                    min_delta_objective = delta_objective;
+                    best = {true, p, d};
+                }
+            }
+        }
+        return best;
+    }
+
+    /** @brief Position to insert the delivery: as Vehicle_pickDeliver::semiLIFO does
+     *
+     * @param [in] drop the delivery node of an order whose pickup is already on the route
+     * @param [in] drop_pos range of positions for the delivery on the new route
+     *
+     * @returns the highest position that keeps the route feasible and is not followed by a pickup
+     * @returns size() when there is no such position
+     *
+     * Only the delivery is inserted: the nodes before it keep their schedule and the nodes after it
+     * shift their cargo by the delivery's demand, so each position is checked in constant time.
+     */
+    size_t lifo_drop_position(const Tw_node &drop, std::pair<size_t, size_t> drop_pos) const {
+        auto n = size();
+        pgassert(drop_pos.first > 0);
+        pgassert(drop_pos.second < n);
+        if (drop_pos.second < drop_pos.first) return n;
+
+        /* cargo bounds of the nodes from k to the node before the end */
+        std::vector<Amount> min_cargo(n, (std::numeric_limits<Amount>::max)());
+        std::vector<Amount> max_cargo(n, (std::numeric_limits<Amount>::min)());
+        for (auto k = n - 1; k-- > 0; ) {
+            min_cargo[k] = std::min(min_cargo[k + 1], m_cargo[k]);
+            max_cargo[k] = std::max(max_cargo[k + 1], m_cargo[k]);
+        }
+
+        for (auto d = drop_pos.second + 1; d-- > drop_pos.first; ) {
+            if (m_is_pickup[d]) continue;
+
+            auto prev = d - 1;
+            if (m_twvTot[prev] != 0 || m_cvTot[prev] != 0) continue;
+
+            auto drop_arrival = m_departure[prev]
+                + Travel::by_index(m_matrix, m_matrix_idx[prev], drop.matrix_idx(), 0, m_speed);
+            if (drop.is_late_arrival(drop_arrival)) continue;
+            if (!in_capacity(m_cargo[prev] + drop.demand())) continue;
+
+            auto drop_departure = std::max(drop_arrival, drop.opens()) + drop.service_time();
+            auto arrival = drop_departure + Travel::by_index(m_matrix, drop.matrix_idx(), m_matrix_idx[d], 0, m_speed);
+            if (m_latest[d] == no_arrival || arrival > m_latest[d]) continue;
+
+            /* the ending node must be empty, the others within the capacity */
+            if (m_cargo[n - 1] + drop.demand() != 0) continue;
+            if (d < n - 1
+                    && !(in_capacity(min_cargo[d] + drop.demand()) && in_capacity(max_cargo[d] + drop.demand()))) continue;
+            return d;
+        }
+        return n;
+    }
+
+ private:
+    /** value of the latest arrival when the node can not be on time */
+    static constexpr TTimestamp no_arrival = (std::numeric_limits<TTimestamp>::min)();
+
+    /** @brief cargo of a node that is not the start nor the end */
+    bool in_capacity(Amount cargo) const {
+        return !(cargo > m_capacity || cargo < 0);
+    }
+
+    /** @brief travel time from every node of the route to @b node */
+    std::vector<TInterval> travel_times_to(const Tw_node &node) const {
+        std::vector<TInterval> result(size());
+        for (size_t k = 0; k < size(); ++k) {
+            result[k] = Travel::by_index(m_matrix, m_matrix_idx[k], node.matrix_idx(), 0, m_speed);
+        }
+        return result;
+    }
+
+    /** @brief travel time from @b node to every node of the route */
+    std::vector<TInterval> travel_times_from(const Tw_node &node) const {
+        std::vector<TInterval> result(size());
+        for (size_t k = 0; k < size(); ++k) {
+            result[k] = Travel::by_index(m_matrix, node.matrix_idx(), m_matrix_idx[k], 0, m_speed);
+        }
+        return result;
+    }
+
+    /** @brief latest arrival to each node that keeps the node and the nodes after it on time
+     *
+     * The departure time is max(arrival, opens) + service, that is not decreasing on the arrival,
+     * so the nodes are on time exactly when the arrival is not after the latest arrival
+     */
+    void set_latest_arrival() {
+        auto n = size();
+        m_latest.assign(n, no_arrival);
+        if (n == 0) return;
+        m_latest[n - 1] = m_closes[n - 1];
+        for (auto k = n - 1; k-- > 0; ) {
+            if (m_latest[k + 1] == no_arrival) break;
+            auto arc = m_tot_travel[k + 1] - m_tot_travel[k];
+            auto latest_departure = m_latest[k + 1] - arc - m_service[k];
+            if (latest_departure < m_opens[k]) break;
+            m_latest[k] = std::min(m_closes[k], latest_departure);
+        }
+    }
+
+    const Matrix &m_matrix;
+    PAmount m_capacity;
+    Speed m_speed;
+
+    /** @name attributes of the nodes on the route */
+    /** @{ */
+    std::vector<Idx> m_matrix_idx;
+    std::vector<TTimestamp> m_opens;
+    std::vector<TTimestamp> m_closes;
+    std::vector<TInterval> m_service;
+    std::vector<TTimestamp> m_departure;
+    std::vector<TInterval> m_tot_travel;
+    std::vector<Amount> m_cargo;
+    std::vector<int> m_twvTot;
+    std::vector<int> m_cvTot;
+    std::vector<bool> m_is_pickup;
+    std::vector<TTimestamp> m_latest;
+    /** @} */
+};
+
+}  // namespace problem
+}  // namespace vrprouting
+
+#endif  // INCLUDE_PROBLEM_ROUTE_SNAPSHOT_HPP_
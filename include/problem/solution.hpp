@@ -120,6 +120,9 @@ class Solution : public Messages {
     Fleet& vehicles() {return m_trucks;}
 
  protected:
+    /** @brief moves the vehicles of the fleet to the order given by their positions */
+    void arrange_fleet(const std::vector<size_t> &positions);
+
     /** The current solution */
     std::deque<Vehicle_pickDeliver> m_fleet;
 
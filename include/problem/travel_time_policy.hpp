@@ -0,0 +1,134 @@
+/*PGR-GNU*****************************************************************
+
+FILE: travel_time_policy.hpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#ifndef INCLUDE_PROBLEM_TRAVEL_TIME_POLICY_HPP_
+#define INCLUDE_PROBLEM_TRAVEL_TIME_POLICY_HPP_
+#pragma once
+
+#include "c_types/typedefs.h"
+#include "problem/matrix.hpp"
+#include "problem/tw_node.hpp"
+
+namespace vrprouting {
+namespace problem {
+
+/** @name Travel time policies
+ *
+ * The route evaluation is instantiated once per combination of policies,
+ * so the choice between the kinds of matrix and of speed is made once per route
+ * and not on every arc.
+ *
+ * - Matrix policy: how to get the travel time between two matrix indices
+ * - Speed policy: how to apply the vehicle's speed to the travel time
+ */
+/** @{ */
+
+/** @brief The cells of the matrix are stored in 32 bits */
+struct Compact_cells {
+    static TInterval at(const Matrix &matrix, Idx i, Idx j) {
+        return matrix.compact_at(i, j);
+    }
+};
+
+/** @brief The cells of the matrix are stored in 64 bits */
+struct Wide_cells {
+    static TInterval at(const Matrix &matrix, Idx i, Idx j) {
+        return matrix.wide_at(i, j);
+    }
+};
+
+/** @brief The matrix has a single multiplier: the travel time is the cell
+ *
+ * @tparam Cells how the cells are stored: Compact_cells or Wide_cells
+ */
+template <typename Cells>
+struct Static_matrix {
+    static TInterval travel_time(const Matrix &matrix, Idx i, Idx j, TTimestamp) {
+        return Cells::at(matrix, i, j);
+    }
+};
+
+/** @brief The matrix has time dependant multipliers */
+struct Time_dependent_matrix {
+    static TInterval travel_time(const Matrix &matrix, Idx i, Idx j, TTimestamp departure) {
+        return matrix.time_dependent_travel_time(i, j, departure);
+    }
+};
+
+/** @brief The vehicle's speed is 1: the travel time is not modified */
+struct Unit_speed {
+    static TInterval travel_time(TInterval travel_time, Speed) {
+        return travel_time;
+    }
+};
+
+/** @brief The travel time is divided by the vehicle's speed */
+struct Scaled_speed {
+    static TInterval travel_time(TInterval travel_time, Speed speed) {
+        return static_cast<TInterval>(static_cast<Speed>(travel_time) / speed);
+    }
+};
+
+/** @brief Travel time between two nodes using a matrix and a speed policy */
+template <typename Matrix_policy, typename Speed_policy>
+struct Travel_time {
+    static TInterval between(const Tw_node &from, const Tw_node &to, TTimestamp departure, Speed speed) {
+        return by_index(from.time_matrix(), from.matrix_idx(), to.matrix_idx(), departure, speed);
+    }
+
+    static TInterval by_index(const Matrix &matrix, Idx i, Idx j, TTimestamp departure, Speed speed) {
+        return Speed_policy::travel_time(Matrix_policy::travel_time(matrix, i, j, departure), speed);
+    }
+};
+
+/** @brief calls @b evaluation with the travel time policy of a matrix with a single multiplier
+ *
+ * The storage of the cells and the kind of speed are decided here, once for all the arcs of the evaluation
+ *
+ * @param [in] matrix the time matrix
+ * @param [in] speed the vehicle's speed
+ * @param [in] evaluation called with a value of type Travel_time<Static_matrix<Cells>, Speed_policy>
+ * @returns the value returned by @b evaluation
+ *
+ * @pre not matrix.is_time_dependent()
+ */
+template <typename Evaluation>
+auto with_static_travel_time(const Matrix &matrix, Speed speed, Evaluation &&evaluation) {
+    if (matrix.is_compact()) {
+        return speed == 1.0 ?
+            evaluation(Travel_time<Static_matrix<Compact_cells>, Unit_speed>()) :
+            evaluation(Travel_time<Static_matrix<Compact_cells>, Scaled_speed>());
+    }
+    return speed == 1.0 ?
+        evaluation(Travel_time<Static_matrix<Wide_cells>, Unit_speed>()) :
+        evaluation(Travel_time<Static_matrix<Wide_cells>, Scaled_speed>());
+}
+
+/** @} */
+
+}  // namespace problem
+}  // namespace vrprouting
+
+#endif  // INCLUDE_PROBLEM_TRAVEL_TIME_POLICY_HPP_
@@ -59,17 +59,25 @@ class Tw_node : public Identifier {
      /** @brief Creating a Tw_node is not permitted */
      Tw_node() = delete;
 
-     /** @brief Creating a Tw_node from a postgreSQL order */
+     /** @brief Creating a Tw_node from a postgreSQL order
+      *
+      * @throws std::pair<std::string, std::string> when the node is not on the time matrix
+      */
      Tw_node(
              size_t id,
              const Orders_t &data,
-             const NodeType &type);
+             const NodeType &type,
+             const Matrix &time_matrix);
 
-     /** @brief Creating a Tw_node from a postgreSQL vehicle */
+     /** @brief Creating a Tw_node from a postgreSQL vehicle
+      *
+      * @throws std::pair<std::string, std::string> when the node is not on the time matrix
+      */
      Tw_node(
              size_t id,
              const Vehicle_t &data,
-             const NodeType &type);
+             const NodeType &type,
+             const Matrix &time_matrix);
 
      /** @brief Returns the order to which it belongs.*/
      inline int64_t order() const {return m_order;}
@@ -136,7 +144,11 @@ class Tw_node : public Identifier {
      /** @brief travel time to other node. */
      TInterval travel_time_to(const Tw_node&, TTimestamp, Speed = 1.0) const;
 
-     static const Matrix* m_time_matrix_ptr;
+     /** @brief Returns the index of the node on the time matrix */
+     inline Idx matrix_idx() const {return m_matrix_idx;}
+
+     /** @brief Returns the time matrix of the problem the node belongs to */
+     inline const Matrix& time_matrix() const {return *m_time_matrix_ptr;}
 
      /** is possible to arrive to @b this after visiting @b other? */
      bool is_compatible_IJ(const Tw_node &I, Speed = 1.0) const;
@@ -169,6 +181,10 @@ class Tw_node : public Identifier {
      /** @brief Sets the demand value to a new value */
      inline void demand(Amount value) {m_demand = value;}
 
+ private:
+     /** @brief Stores the index of the node on the time matrix */
+     void set_matrix_idx();
+
  private:
      /** order to which it belongs (idx) */
      int64_t m_order { };
@@ -187,6 +203,19 @@ class Tw_node : public Identifier {
 
      /** The kind of Node */
      NodeType m_type;
+
+     /** time matrix of the problem the node belongs to
+      *
+      * Each node holds its problem's matrix, so several problems can be solved at the same time
+      */
+     const Matrix *m_time_matrix_ptr;
+
+     /** index of the node on the time matrix
+      *
+      * Resolved once at construction: the travel time calls do not look up the node's identifier.
+      * The drivers build the matrix with all the nodes of the problem, a node that is not on it is an error.
+      */
+     Idx m_matrix_idx {0};
 };
 
 }  //  namespace problem
@@ -35,9 +35,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "c_types/solution_rt.h"
 
 #include "cpp_common/assert.hpp"
+#include "cpp_common/fingerprint_set.hpp"
 #include "cpp_common/identifier.hpp"
 #include "cpp_common/messages.hpp"
 #include "problem/vehicle_node.hpp"
+#include "problem/reachability.hpp"
 
 namespace vrprouting {
 namespace problem {
@@ -110,13 +112,32 @@ class Vehicle : public Messages, public Identifier, protected std::deque<Vehicle
 
      std::string path_str() const;
 
+     /** @brief hash of path_str() */
+     uint64_t path_hash() const {return back().path_hash();}
+
+     /** @brief hash of the vehicle and its path
+      *
+      * The identifier of the vehicle is not unique: the copies of a vehicle (its @b number) share it
+      */
+     uint64_t route_hash() const {return hash_combine(static_cast<uint64_t>(idx()), path_hash());}
+
      std::string tau() const;
 
+     /** @brief sets the precomputed "can follow" matrices: for the vehicle's speed and for speed 1 */
+     void set_reachability(const Reachability *reachability, const Reachability *unit_reachability) {
+         m_reachability = reachability;
+         m_unit_reachability = unit_reachability;
+     }
+
  protected:
      void evaluate();
 
      void evaluate(size_t from);
 
+     /** @brief evaluate from @b from to the end of the path using a travel time policy */
+     template <typename Travel>
+     void evaluate_path(size_t from);
+
      void erase_node(size_t pos);
 
      void insert_node(size_t pos, const Vehicle_node &node);
@@ -178,8 +199,21 @@ class Vehicle : public Messages, public Identifier, protected std::deque<Vehicle
      int m_user_cv {0};
 
  private:
+     /** @brief can @b J be visited after @b I? using the matrix when there is one */
+     static bool can_follow(
+             const Reachability *reachability,
+             const Vehicle_node &I, const Vehicle_node &J, Speed speed) {
+         return reachability ? reachability->can_follow(I, J) : J.is_compatible_IJ(I, speed);
+     }
+
      PAmount m_capacity;
      Speed m_speed = 1.0;
+
+     /** "can follow" matrix for the vehicle's speed, nullptr when it was not computed */
+     const Reachability *m_reachability {nullptr};
+
+     /** "can follow" matrix for speed 1, nullptr when it was not computed */
+     const Reachability *m_unit_reachability {nullptr};
 };
 
 }  // namespace problem
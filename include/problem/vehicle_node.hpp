@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #pragma once
 
 
+#include <cstdint>
 #include <string>
 
 #include "problem/tw_node.hpp"
@@ -89,6 +90,12 @@ class Vehicle_node: public Tw_node {
 
      /** @brief _time spent by the truck servicing the nodes */
      inline TInterval total_service_time() const {return m_tot_service_time;}
+
+     /** @brief hash of the path from the starting node up to this node
+      *
+      * Same information as Vehicle::path_str: the kind of each node and the order of the pickups and deliveries
+      */
+     inline uint64_t path_hash() const {return m_path_hash;}
      /** @} */
 
      /** @brief the basic objective function for this node */
@@ -99,8 +106,21 @@ class Vehicle_node: public Tw_node {
 
      void evaluate(const Vehicle_node &pred, PAmount, Speed = 1.0);
 
+     /** @brief evaluate this node using a travel time policy
+      *
+      * @tparam Travel a Travel_time<Matrix_policy, Speed_policy> from travel_time_policy.hpp
+      */
+     template <typename Travel>
+     void evaluate(const Vehicle_node &pred, PAmount cargoLimit, Speed speed) {
+         evaluate_arrival(pred, cargoLimit, Travel::between(pred, *this, pred.departure_time(), speed));
+     }
+
      Solution_rt get_postgres_result(int vid, int64_t v_id, int stop_seq) const;
 
+ private:
+     /** @brief evaluate this node when arriving from @b pred after @b arc_time */
+     void evaluate_arrival(const Vehicle_node &pred, PAmount cargoLimit, TInterval arc_time);
+
  protected:
      /** @name evaluation */
      /** @{ */
@@ -174,7 +194,13 @@ class Vehicle_node: public Tw_node {
 
      /** Accumulated service time */
      TInterval m_tot_service_time;
+
+     /** Hash of the path up to this node */
+     uint64_t m_path_hash;
      /** @} */
+
+     /** @brief the contribution of this node to the path hash */
+     uint64_t hash_token() const;
 };
 
 }  //  namespace problem
@@ -92,12 +92,21 @@ class Vehicle_pickDeliver : public Vehicle {
      /** @brief Inserts an order with hill Climb approach*/
      bool hillClimb(const Order &order);
 
+     /** @brief Increase of the travel time when the order is inserted with hill Climb, the route does not change */
+     TInterval insertion_delta(const Order &order);
+
+     /** @brief insertion_delta of an order that can not be inserted */
+     static constexpr TInterval infeasible_delta = (std::numeric_limits<TInterval>::max)();
+
      /** @brief Inserts an order In semi-Lifo (almost last in first out) order */
      bool semiLIFO(const Order &order);
 
      /** @brief erases the order from the vehicle */
      void erase(const Order &order);
 
+     /** @brief Moves the nodes inside the route while the travel time decreases */
+     bool improve_route();
+
      size_t pop_back();
      size_t pop_front();
 
@@ -106,6 +115,18 @@ class Vehicle_pickDeliver : public Vehicle {
      /** @brief Get the value of the objective function */
      double objective() const;
 
+     /** @brief The route of the vehicle: the evaluated nodes and the orders that can be moved */
+     struct Route {
+         std::vector<Vehicle_node> nodes;
+         Identifiers<size_t> orders_in_vehicle;
+     };
+
+     /** @brief copy of the route of the vehicle */
+     Route route() const;
+
+     /** @brief replaces the route with one taken from this vehicle with @b route() */
+     void set_route(const Route &route);
+
 
      /** @brief sets the initial solution given by the user */
      void set_initial_solution(const Orders&, Identifiers<size_t>&, Identifiers<size_t>&, TTimestamp, bool);
@@ -35,6 +35,7 @@ CREATE OR REPLACE FUNCTION _vrp_optimize(
   FLOAT,   -- factor
   INTEGER, -- max cycles
   BIGINT,   -- execution date
+  INTEGER, -- timeout in milliseconds
 
 
   BOOLEAN,  -- check triangle inequality
@@ -52,5 +53,5 @@ LANGUAGE c VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION _vrp_optimize(TEXT, TEXT, TEXT, TEXT, FLOAT, INTEGER, BIGINT, BOOLEAN, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION _vrp_optimize(TEXT, TEXT, TEXT, TEXT, FLOAT, INTEGER, BIGINT, INTEGER, BOOLEAN, INTEGER, BOOLEAN)
 IS 'vrprouting internal function';
@@ -35,7 +35,8 @@ CREATE OR REPLACE PROCEDURE vrp_optimize(
 
   execution_date TIMESTAMP,
   factor         FLOAT,
-  max_cycles     INTEGER
+  max_cycles     INTEGER,
+  timeout        INTERVAL DEFAULT '-00:00:01'::INTERVAL
 )
 AS
 $BODY$
@@ -124,7 +125,8 @@ BEGIN
         optimize => true,
         factor => factor,
         max_cycles => max_cycles,
-        stop_on_all_served => false);
+        stop_on_all_served => false,
+        timeout => timeout);
 
       EXCEPTION WHEN OTHERS THEN
           RAISE WARNING 'COULD NOT OPTIMIZE %', curr_time;
@@ -153,7 +155,7 @@ END;
 $BODY$
 LANGUAGE plpgsql;
 
-COMMENT ON PROCEDURE vrp_optimize(TEXT, TEXT, TEXT, TEXT, REGCLASS, TIMESTAMP, FLOAT, INTEGER)
+COMMENT ON PROCEDURE vrp_optimize(TEXT, TEXT, TEXT, TEXT, REGCLASS, TIMESTAMP, FLOAT, INTEGER, INTERVAL)
 IS 'vrp_optimize
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_optimize.html
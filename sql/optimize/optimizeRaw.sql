@@ -38,6 +38,7 @@ CREATE OR REPLACE FUNCTION vrp_optimizeRaw(
 
   check_triangle_inequality BOOLEAN DEFAULT false,
   subdivision_kind          INTEGER DEFAULT '0',
+  timeout                   INTERVAL DEFAULT '-00:00:01'::INTERVAL,
 
   OUT seq INTEGER,
   OUT vehicle_id BIGINT,
@@ -52,7 +53,7 @@ $BODY$
     _pgr_get_statement($2),
     _pgr_get_statement($3),
     _pgr_get_statement($4),
-    factor, max_cycles, execution_date,
+    factor, max_cycles, execution_date, _vrp_timeout(timeout),
     check_triangle_inequality, subdivision_kind,
     false);
 
@@ -60,7 +61,7 @@ $BODY$
 LANGUAGE SQL VOLATILE STRICT;
 
 
-COMMENT ON FUNCTION vrp_optimizeRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, FLOAT, INTEGER, BOOLEAN, INTEGER)
+COMMENT ON FUNCTION vrp_optimizeRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, FLOAT, INTEGER, BOOLEAN, INTEGER, INTERVAL)
 IS 'vrp_optimizeRaw
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_optimizeRaw.html
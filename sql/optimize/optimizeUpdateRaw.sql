@@ -41,7 +41,8 @@ CREATE OR REPLACE PROCEDURE vrp_optimizeUpdateRaw(
   max_cycles      INTEGER DEFAULT 1,
 
   check_triangle_inequality BOOLEAN DEFAULT false,
-  subdivision_kind          INTEGER DEFAULT '0'
+  subdivision_kind          INTEGER DEFAULT '0',
+  timeout                   INTERVAL DEFAULT '-00:00:01'::INTERVAL
 )
 AS
 $BODY$
@@ -57,20 +58,20 @@ BEGIN
       SELECT vehicle_id, array_agg(order_id ORDER BY seq) AS stops
     FROM _vrp_optimize(
       %1$L, %2$L, %3$L, %4$L,
-      %5$s, %6$s, %7$s,
-      %8$L, %9$s,
+      %5$s, %6$s, %7$s, %8$s,
+      %9$L, %10$s,
       false)
     GROUP BY vehicle_id
   )
-  UPDATE %10$I AS v
-  SET %11$I = n.stops
-  FROM new_stops AS n WHERE v.%12$I = n.vehicle_id
+  UPDATE %11$I AS v
+  SET %12$I = n.stops
+  FROM new_stops AS n WHERE v.%13$I = n.vehicle_id
   $$,
   _pgr_get_statement($1),
   _pgr_get_statement($2),
   _pgr_get_statement($3),
   _pgr_get_statement($4),
-  factor, max_cycles, execution_date,
+  factor, max_cycles, execution_date, _vrp_timeout(timeout),
   check_triangle_inequality, subdivision_kind,
   vehicles_tbl, stops_column, id_column);
 
@@ -82,7 +83,7 @@ $BODY$
 LANGUAGE plpgsql;
 
 
-COMMENT ON PROCEDURE vrp_optimizeUpdateRaw(TEXT, TEXT, TEXT, TEXT, REGCLASS, TEXT, TEXT, BIGINT, FLOAT, INTEGER, BOOLEAN, INTEGER)
+COMMENT ON PROCEDURE vrp_optimizeUpdateRaw(TEXT, TEXT, TEXT, TEXT, REGCLASS, TEXT, TEXT, BIGINT, FLOAT, INTEGER, BOOLEAN, INTEGER, INTERVAL)
 IS 'vrp_optimizeUpdateRaw
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_optimizeUpdateRaw.html
@@ -34,6 +34,7 @@ CREATE FUNCTION _vrp_pgr_pickDeliver(
     factor FLOAT DEFAULT 1,
     max_cycles INTEGER DEFAULT 10,
     initial_sol INTEGER DEFAULT 4,
+    timeout INTEGER DEFAULT -1, -- milliseconds
 
     OUT seq INTEGER,
     OUT vehicle_seq INTEGER,
@@ -54,5 +55,5 @@ LANGUAGE c VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION _vrp_pgr_pickDeliver(TEXT, TEXT, TEXT, FLOAT, INTEGER, INTEGER)
+COMMENT ON FUNCTION _vrp_pgr_pickDeliver(TEXT, TEXT, TEXT, FLOAT, INTEGER, INTEGER, INTEGER)
 IS 'pgRouting internal function';
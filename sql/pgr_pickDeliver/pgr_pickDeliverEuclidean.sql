@@ -34,6 +34,7 @@ CREATE FUNCTION vrp_pgr_pickDeliverEuclidean(
     factor FLOAT DEFAULT 1,
     max_cycles INTEGER DEFAULT 10,
     initial_sol INTEGER DEFAULT 4,
+    timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
 
     OUT seq INTEGER,
     OUT vehicle_seq INTEGER,
@@ -50,13 +51,13 @@ CREATE FUNCTION vrp_pgr_pickDeliverEuclidean(
 RETURNS SETOF RECORD AS
 $BODY$
     SELECT *
-    FROM _vrp_pgr_pickDeliverEuclidean(_pgr_get_statement($1), _pgr_get_statement($2), $3, $4, $5);
+    FROM _vrp_pgr_pickDeliverEuclidean(_pgr_get_statement($1), _pgr_get_statement($2), $3, $4, $5, _vrp_timeout(timeout));
 $BODY$
 LANGUAGE SQL VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION vrp_pgr_pickDeliverEuclidean(TEXT, TEXT, FLOAT, INTEGER, INTEGER)
+COMMENT ON FUNCTION vrp_pgr_pickDeliverEuclidean(TEXT, TEXT, FLOAT, INTEGER, INTEGER, INTERVAL)
 IS 'vrp_pgr_pickDeliverEuclidean
  - EXPERIMENTAL
  - Parameters:
@@ -79,6 +80,7 @@ IS 'vrp_pgr_pickDeliverEuclidean
    - factor: default := 1
    - max_cycles: default := 10
    - initial_sol: default := 4
+   - timeout: default := '-00:00:01'::INTERVAL
 - Documentation:
    - ${PROJECT_DOC_LINK}/vrp_pgr_pickDeliver.html
 ';
@@ -37,6 +37,10 @@ CREATE OR REPLACE FUNCTION _vrp_pickDeliverRaw(
   INTEGER, -- max cycles
   BOOLEAN, -- stop on all served
   BIGINT,   -- execution date
+  INTEGER, -- timeout in milliseconds
+  INTEGER, -- optimizer
+  INTEGER, -- threads
+  INTEGER, -- regret
 
 
   OUT seq INTEGER,
@@ -71,6 +75,10 @@ CREATE OR REPLACE FUNCTION _vrp_pickDeliver(
   INTEGER, -- max cycles
   BOOLEAN, -- stop on all served
   TIMESTAMP,   -- execution date
+  INTEGER, -- timeout in milliseconds
+  INTEGER, -- optimizer
+  INTEGER, -- threads
+  INTEGER, -- regret
 
   OUT seq INTEGER,
   OUT vehicle_seq INTEGER,
@@ -95,8 +103,8 @@ LANGUAGE c VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION _vrp_pickDeliverRaw(TEXT, TEXT, TEXT, TEXT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, BIGINT)
+COMMENT ON FUNCTION _vrp_pickDeliverRaw(TEXT, TEXT, TEXT, TEXT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, BIGINT, INTEGER, INTEGER, INTEGER, INTEGER)
 IS 'vrprouting internal function';
 
-COMMENT ON FUNCTION _vrp_pickDeliver(TEXT, TEXT, TEXT, TEXT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, TIMESTAMP)
+COMMENT ON FUNCTION _vrp_pickDeliver(TEXT, TEXT, TEXT, TEXT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, TIMESTAMP, INTEGER, INTEGER, INTEGER, INTEGER)
 IS 'vrprouting internal function';
@@ -37,6 +37,10 @@ CREATE OR REPLACE FUNCTION vrp_pickDeliver(
   factor FLOAT DEFAULT 1,
   max_cycles INTEGER DEFAULT 1,
   stop_on_all_served BOOLEAN DEFAULT true,
+  timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
+  optimizer INTEGER DEFAULT 0,
+  threads INTEGER DEFAULT 1,
+  regret INTEGER DEFAULT 0,
 
   OUT seq           INTEGER,
   OUT vehicle_seq   INTEGER,
@@ -100,14 +104,18 @@ FROM (
       factor,
       max_cycles,
       stop_on_all_served,
-      execution_date)) AS b) AS a;
+      execution_date,
+      _vrp_timeout(timeout),
+      optimizer,
+      threads,
+      regret)) AS b) AS a;
 
 $BODY$
 LANGUAGE SQL VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION vrp_pickDeliver(TEXT, TEXT, TEXT, TEXT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION vrp_pickDeliver(TEXT, TEXT, TEXT, TEXT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN, INTERVAL, INTEGER, INTEGER, INTEGER)
 IS 'vrp_pickDeliver
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_pickDeliver.html
@@ -37,6 +37,10 @@ CREATE OR REPLACE FUNCTION vrp_pickDeliverRaw(
   factor FLOAT DEFAULT 1,
   max_cycles INTEGER DEFAULT 1,
   stop_on_all_served BOOLEAN DEFAULT true,
+  timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
+  optimizer INTEGER DEFAULT 0,
+  threads INTEGER DEFAULT 1,
+  regret INTEGER DEFAULT 0,
 
   OUT seq INTEGER,
   OUT vehicle_seq INTEGER,
@@ -65,7 +69,7 @@ SELECT * FROM _vrp_pickDeliverRaw(
   _pgr_get_statement($3),
   _pgr_get_statement($4),
   optimize, factor,
-  max_cycles, stop_on_all_served, execution_date);
+  max_cycles, stop_on_all_served, execution_date, _vrp_timeout(timeout), optimizer, threads, regret);
 
 $BODY$
 LANGUAGE SQL
@@ -73,7 +77,7 @@ VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION vrp_pickDeliverRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, BOOLEAN, FLOAT, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION vrp_pickDeliverRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, INTERVAL, INTEGER, INTEGER, INTEGER)
 IS 'vrp_pickDeliver
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_pickDeliverRaw.html
@@ -38,6 +38,7 @@ CREATE OR REPLACE FUNCTION _vrp_pickDeliverAdd(
   factor FLOAT DEFAULT 1,
   max_cycles INTEGER DEFAULT 1,
   stop_on_all_served BOOLEAN DEFAULT true,
+  timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
 
   OUT seq INTEGER,
   OUT vehicle_seq INTEGER,
@@ -128,7 +129,7 @@ BEGIN
     $3,
     $4,
     optimize, factor, max_cycles, stop_on_all_served,
-    execution_date);
+    execution_date, _vrp_timeout(timeout), 0, 1, 0);
 
   EXCEPTION
     WHEN OTHERS THEN
@@ -143,5 +144,5 @@ LANGUAGE plpgsql VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION _vrp_pickDeliverAdd(TEXT, TEXT, TEXT, TEXT, BIGINT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION _vrp_pickDeliverAdd(TEXT, TEXT, TEXT, TEXT, BIGINT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN, INTERVAL)
 IS '_vrp_pickDeliverAdd is internal function';
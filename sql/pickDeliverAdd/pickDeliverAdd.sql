@@ -38,6 +38,7 @@ CREATE OR REPLACE FUNCTION vrp_pickDeliverAdd(
   factor FLOAT DEFAULT 1,
   max_cycles INTEGER DEFAULT 1,
   stop_on_all_served BOOLEAN DEFAULT true,
+  timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
 
   OUT seq           INTEGER,
   OUT vehicle_seq   INTEGER,
@@ -100,14 +101,14 @@ SELECT
 FROM (
   SELECT *,
     lead(b.wait_fd) OVER(ORDER BY b.seq) AS lead_wait
-  FROM (SELECT * FROM _vrp_pickDeliverAdd($1, $2, $3, $4, $5, execution_date, optimize, factor, max_cycles, stop_on_all_served)) AS b
+  FROM (SELECT * FROM _vrp_pickDeliverAdd($1, $2, $3, $4, $5, execution_date, optimize, factor, max_cycles, stop_on_all_served, timeout)) AS b
   ) AS a;
 
 $BODY$
 LANGUAGE SQL VOLATILE STRICT;
 
 
-COMMENT ON FUNCTION vrp_pickDeliverAdd(TEXT, TEXT, TEXT, TEXT, BIGINT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION vrp_pickDeliverAdd(TEXT, TEXT, TEXT, TEXT, BIGINT, TIMESTAMP, BOOLEAN, FLOAT, INTEGER, BOOLEAN, INTERVAL)
 IS 'vrp_pickDeliverAdd
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_pickDeliverAdd.html
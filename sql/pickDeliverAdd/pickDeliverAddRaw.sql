@@ -38,6 +38,7 @@ CREATE OR REPLACE FUNCTION vrp_pickDeliverAddRaw(
   factor FLOAT DEFAULT 1,
   max_cycles INTEGER DEFAULT 1,
   stop_on_all_served BOOLEAN DEFAULT true,
+  timeout INTERVAL DEFAULT '-00:00:01'::INTERVAL,
 
   OUT seq INTEGER,
   OUT vehicle_seq INTEGER,
@@ -125,7 +126,7 @@ BEGIN
     $3,
     $4,
     optimize, factor, max_cycles, stop_on_all_served,
-    execution_date);
+    execution_date, _vrp_timeout(timeout), 0, 1, 0);
 
 
   -- call main code
@@ -139,7 +140,7 @@ LANGUAGE plpgsql VOLATILE STRICT;
 
 -- COMMENTS
 
-COMMENT ON FUNCTION vrp_pickDeliverAddRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, BIGINT, BOOLEAN, FLOAT, INTEGER, BOOLEAN)
+COMMENT ON FUNCTION vrp_pickDeliverAddRaw(TEXT, TEXT, TEXT, TEXT, BIGINT, BIGINT, BOOLEAN, FLOAT, INTEGER, BOOLEAN, INTERVAL)
 IS 'vrp_pickDeliverAddRaw
 - Documentation:
   - ${PROJECT_DOC_LINK}/vrp_pickDeliverAddRaw.html';
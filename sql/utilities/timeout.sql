@@ -0,0 +1,54 @@
+/*PGR-GNU*****************************************************************
+File: timeout.sql
+
+Copyright (c) 2024 pgRouting developers
+Mail: project@pgrouting.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+/*
+ * The timeout in milliseconds that the C code uses
+ * - '-00:00:01': no time limit -> -1
+ * - other negative values are an error
+ * - rounds up: a positive interval is at least 1 millisecond
+ * - clamped to the largest INTEGER: about 24 days
+ */
+CREATE OR REPLACE FUNCTION _vrp_timeout(
+  INTERVAL -- timeout
+)
+RETURNS INTEGER AS
+$BODY$
+BEGIN
+  IF $1 = '-00:00:01'::INTERVAL THEN
+    RETURN -1;
+  END IF;
+
+  IF $1 < '00:00:00'::INTERVAL THEN
+    RAISE EXCEPTION 'Illegal value in parameter: timeout'
+    USING HINT = 'Expected value: timeout >= 0 or timeout = ''-00:00:01'' (no time limit)';
+  END IF;
+
+  RETURN LEAST(CEIL(EXTRACT(epoch FROM $1) * 1000), 2147483647)::INTEGER;
+END;
+$BODY$
+LANGUAGE plpgsql IMMUTABLE STRICT;
+
+
+COMMENT ON FUNCTION _vrp_timeout(INTERVAL)
+IS 'vrp_timeout is a vrprouting internal function';
@@ -280,6 +280,8 @@ Base_Matrix::Base_Matrix(
   for (size_t i = 0; i < m_time_matrix.size(); ++i) {
     m_time_matrix[i][i] = 0;
   }
+
+  compact();
 }
 
 
@@ -310,6 +312,8 @@ Base_Matrix::Base_Matrix(const std::map<std::pair<Coordinate, Coordinate>, Id> &
   for (size_t i = 0; i < m_time_matrix.size(); ++i) {
     m_time_matrix[i][i] = 0;
   }
+
+  compact();
 }
 
 
@@ -344,14 +348,14 @@ Base_Matrix::has_no_infinity() const {
   /*
    * Cycle the matrix
    */
-  for (const auto &row : m_time_matrix) {
-    for (const auto &val : row) {
+  for (size_t i = 0; i < size(); ++i) {
+    for (size_t j = 0; j < size(); ++j) {
       /*
        * found infinity?
        *
        * yes -> return false
        */
-      if (val == (std::numeric_limits<TInterval>::max)()) return false;
+      if (at(i, j) == (std::numeric_limits<TInterval>::max)()) return false;
     }
   }
   /*
@@ -369,10 +373,10 @@ Base_Matrix::has_no_infinity() const {
  */
 bool
 Base_Matrix::obeys_triangle_inequality() const {
-  for (size_t i = 0; i < m_time_matrix.size(); ++i) {
-    for (size_t j = 0; j < m_time_matrix.size(); ++j) {
-      for (size_t k = 0; k < m_time_matrix.size(); ++k) {
-        if (m_time_matrix[i][k] > (m_time_matrix[i][j] + m_time_matrix[j][k])) {
+  for (size_t i = 0; i < size(); ++i) {
+    for (size_t j = 0; j < size(); ++j) {
+      for (size_t k = 0; k < size(); ++k) {
+        if (at(i, k) > (at(i, j) + at(j, k))) {
           return false;
         }
       }
@@ -390,13 +394,24 @@ Base_Matrix::obeys_triangle_inequality() const {
  */
 size_t
 Base_Matrix::fix_triangle_inequality(size_t depth) {
+  expand();
+  depth = fix_rows_triangle_inequality(depth);
+  compact();
+  return depth;
+}
+
+/*!
+ * Works on the rows of m_time_matrix
+ */
+size_t
+Base_Matrix::fix_rows_triangle_inequality(size_t depth) {
   if (depth > m_time_matrix.size()) return depth;
   for (auto & i : m_time_matrix) {
     for (size_t j = 0; j < m_time_matrix.size(); ++j) {
       for (size_t k = 0; k < m_time_matrix.size(); ++k) {
         if (i[k] > (i[j] + m_time_matrix[j][k])) {
           i[k] = i[j] + m_time_matrix[j][k];
-          return fix_triangle_inequality(++depth);
+          return fix_rows_triangle_inequality(++depth);
         }
       }
     }
@@ -436,28 +451,81 @@ std::ostream& operator<<(std::ostream &log, const Base_Matrix &matrix) {
     log << "\t" << id;
   }
   log << "\n";
-  size_t i = 0;
 
   /*
    * Cycle the cells
+   * (there are no cells while the matrix is being built)
    */
-  for (const auto &row : matrix.m_time_matrix) {
-    size_t j = 0;
-    for (const auto cost : row) {
+  if (matrix.m_cells.empty() && matrix.m_compact_cells.empty()) return log;
+  for (size_t i = 0; i < matrix.size(); ++i) {
+    for (size_t j = 0; j < matrix.size(); ++j) {
       /*
        * print the information
        */
       log << "Internal(" << i << "," << j << ")"
         << "\tOriginal(" << matrix.m_ids[i] << "," << matrix.m_ids[j] << ")"
-        << "\t = " << cost
+        << "\t = " << matrix.at(i, j)
         << "\n";
-      ++j;
     }
-    ++i;
   }
   return log;
 }
 
+/**
+ * @post m_time_matrix is empty
+ * @post the cells are on m_compact_cells when all the values that are not infinity are in
+ *       [INT32_MIN, INT32_MAX), otherwise the cells are on m_cells
+ */
+void
+Base_Matrix::compact() {
+  const auto infinity = (std::numeric_limits<TInterval>::max)();
+  const auto n = m_time_matrix.size();
+
+  bool fits = true;
+  for (const auto &row : m_time_matrix) {
+    for (const auto cost : row) {
+      if (cost == infinity) continue;
+      if (cost < (std::numeric_limits<int32_t>::min)() || cost >= compact_infinity) {
+        fits = false;
+        break;
+      }
+    }
+    if (!fits) break;
+  }
+
+  m_cells.clear();
+  m_compact_cells.clear();
+  if (fits) {
+    m_compact_cells.reserve(n * n);
+    for (const auto &row : m_time_matrix) {
+      for (const auto cost : row) {
+        m_compact_cells.push_back(cost == infinity ? compact_infinity : static_cast<int32_t>(cost));
+      }
+    }
+  } else {
+    m_cells.reserve(n * n);
+    for (const auto &row : m_time_matrix) {
+      m_cells.insert(m_cells.end(), row.begin(), row.end());
+    }
+  }
+  m_cells.shrink_to_fit();
+  m_compact_cells.shrink_to_fit();
+  std::vector<std::vector<TInterval>>().swap(m_time_matrix);
+}
+
+/**
+ * @post m_time_matrix has the cells of the matrix
+ */
+void
+Base_Matrix::expand() {
+  m_time_matrix.assign(size(), std::vector<TInterval>(size()));
+  for (size_t i = 0; i < size(); ++i) {
+    for (size_t j = 0; j < size(); ++j) {
+      m_time_matrix[i][j] = at(i, j);
+    }
+  }
+}
+
 
 }  // namespace base
 }  // namespace vrprouting
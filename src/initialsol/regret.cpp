@@ -0,0 +1,244 @@
+/*PGR-GNU*****************************************************************
+
+FILE: regret.cpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#include "initialsol/regret.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "cpp_common/assert.hpp"
+#include "cpp_common/interruption.hpp"
+#include "cpp_common/parallel_for.hpp"
+
+namespace vrprouting {
+namespace initialsol {
+namespace regret {
+
+/**
+ * @param [in] fleet where the orders are inserted
+ * @param [in] orders of the problem
+ * @param [in] k number of vehicles used to compute the regret
+ * @param [in] time_limit when the time is over the remaining orders are not inserted
+ * @param [in] threads maximum number of threads that compute the costs, 1: no worker threads
+ */
+Insertion::Insertion(
+        std::deque<problem::Vehicle_pickDeliver> &fleet,
+        const problem::Orders &orders,
+        size_t k,
+        const Time_limit &time_limit,
+        size_t threads) :
+    m_fleet(fleet),
+    m_orders(orders),
+    m_k(k),
+    m_time_limit(time_limit),
+    m_threads(threads) {
+        pgassert(k > 0);
+    }
+
+/**
+ * @param [in] pool orders to be inserted, they are not on a vehicle
+ * @param [in] before_insertion called with the vehicle that gets the next order, before it changes
+ * @returns position of the order on @b pool -> the order was inserted
+ */
+std::vector<bool>
+Insertion::insert(const std::vector<size_t> &pool, const std::function<void(size_t)> &before_insertion) {
+    auto n_vehicles = m_fleet.size();
+    m_pool = pool;
+    m_inserted.assign(m_pool.size(), false);
+    m_delta.assign(m_pool.size() * n_vehicles, problem::Vehicle_pickDeliver::infeasible_delta);
+    m_cheapest.assign(m_pool.size(), {});
+    m_entries.assign(m_pool.size(), Entry{0, 0, 0, 0});
+    m_queue.clear();
+    if (m_pool.empty() || n_vehicles == 0) return m_inserted;
+
+    /*
+     * Each thread works on its own vehicles
+     */
+    parallel_for(0, n_vehicles, 1, [&](size_t first, size_t last) {
+        for (auto v = first; v < last; ++v) {
+            for (size_t p = 0; p < m_pool.size(); ++p) {
+                if (!m_fleet[v].feasible_orders().has(m_pool[p])) continue;
+                delta(p, v) = m_fleet[v].insertion_delta(m_orders[m_pool[p]]);
+            }
+        }
+    }, m_threads);
+
+    for (size_t p = 0; p < m_pool.size(); ++p) {
+        choose(p);
+        enqueue(p);
+    }
+
+    while (!m_queue.empty()) {
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) break;
+
+        auto p = m_queue.begin()->position;
+        m_queue.erase(m_queue.begin());
+        m_entries[p].options = 0;
+
+        auto v = m_cheapest[p].front();
+        if (before_insertion) before_insertion(v);
+        m_fleet[v].hillClimb(m_orders[m_pool[p]]);
+        pgassert(m_fleet[v].has_order(m_orders[m_pool[p]]));
+        m_inserted[p] = true;
+
+        update(v);
+    }
+    return m_inserted;
+}
+
+/**
+ * Only the costs on vehicle @b v changed.
+ *
+ * Each thread computes the costs on its own copy of the vehicle.
+ */
+void
+Insertion::update(size_t v) {
+    std::vector<size_t> positions;
+    for (size_t p = 0; p < m_pool.size(); ++p) {
+        if (m_inserted[p] || !m_fleet[v].feasible_orders().has(m_pool[p])) continue;
+        positions.push_back(p);
+    }
+
+    std::vector<TInterval> costs(positions.size());
+    parallel_for(0, positions.size(), orders_per_thread, [&](size_t first, size_t last) {
+        auto vehicle = m_fleet[v];
+        for (auto i = first; i < last; ++i) {
+            costs[i] = vehicle.insertion_delta(m_orders[m_pool[positions[i]]]);
+        }
+    }, m_threads);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        consider(positions[i], v, costs[i]);
+        enqueue(positions[i]);
+    }
+}
+
+/**
+ * When @b v was one of the cheapest vehicles its cost could have gone up:
+ * the cheapest vehicles are chosen again from all the costs of the order
+ */
+void
+Insertion::consider(size_t p, size_t v, TInterval d) {
+    delta(p, v) = d;
+    auto &cheapest = m_cheapest[p];
+    if (std::find(cheapest.begin(), cheapest.end(), v) != cheapest.end()) {
+        choose(p);
+        return;
+    }
+    if (d == problem::Vehicle_pickDeliver::infeasible_delta) return;
+
+    auto position = std::find_if(cheapest.begin(), cheapest.end(), [&](size_t other) {
+            return d < delta(p, other) || (d == delta(p, other) && v < other);
+            });
+    if (cheapest.size() == m_k && position == cheapest.end()) return;
+    cheapest.insert(position, v);
+    if (cheapest.size() > m_k) cheapest.pop_back();
+}
+
+/**
+ * Ties are broken by the position of the vehicle on the fleet
+ */
+void
+Insertion::choose(size_t p) {
+    auto &cheapest = m_cheapest[p];
+    cheapest.clear();
+    for (size_t v = 0; v < m_fleet.size(); ++v) {
+        if (delta(p, v) != problem::Vehicle_pickDeliver::infeasible_delta) cheapest.push_back(v);
+    }
+    auto cheaper = [&](size_t v1, size_t v2) {
+        return delta(p, v1) < delta(p, v2) || (delta(p, v1) == delta(p, v2) && v1 < v2);
+    };
+    auto n = std::min(m_k, cheapest.size());
+    std::partial_sort(cheapest.begin(), cheapest.begin() + static_cast<std::ptrdiff_t>(n), cheapest.end(), cheaper);
+    cheapest.resize(n);
+}
+
+/**
+ * An order without vehicles where it can be inserted is not on the queue
+ */
+void
+Insertion::enqueue(size_t p) {
+    if (m_entries[p].options > 0) m_queue.erase(m_entries[p]);
+
+    const auto &cheapest = m_cheapest[p];
+    Entry entry {cheapest.size(), 0, 0, p};
+    if (!cheapest.empty()) {
+        entry.best = delta(p, cheapest.front());
+        for (size_t j = 1; j < cheapest.size(); ++j) entry.regret += delta(p, cheapest[j]) - entry.best;
+        m_queue.insert(entry);
+    }
+    m_entries[p] = entry;
+}
+
+/**
+ * - The orders leave the phony vehicles
+ * - The orders are inserted on the real vehicles
+ * - The orders that were not inserted go back to phony vehicles, one order per vehicle
+ *
+ * @param [in] solution with the orders to be inserted on phony vehicles
+ * @param [in] k number of vehicles used to compute the regret
+ * @param [in] time_limit when the time is over the remaining orders are not inserted
+ * @param [in] threads maximum number of threads that compute the costs, 1: no worker threads
+ */
+Initial_solution::Initial_solution(
+        const problem::Solution &solution,
+        size_t k,
+        const Time_limit &time_limit,
+        size_t threads) :
+    problem::Solution(solution) {
+        std::vector<size_t> pool;
+        for (const auto &vehicle : m_fleet) {
+            if (!vehicle.is_phony()) continue;
+            for (const auto o_id : vehicle.orders_in_vehicle()) pool.push_back(o_id);
+        }
+        m_fleet.erase(std::remove_if(
+                m_fleet.begin(),
+                m_fleet.end(),
+                [](const problem::Vehicle_pickDeliver &v){return v.is_phony();}),
+                m_fleet.end());
+
+        auto inserted = Insertion(m_fleet, orders(), k, time_limit, threads).insert(pool);
+
+        size_t n_inserted = 0;
+        for (size_t p = 0; p < pool.size(); ++p) {
+            if (inserted[p]) {
+                ++n_inserted;
+                continue;
+            }
+            auto phony_vehicle = vehicles().get_phony();
+            phony_vehicle.push_back(orders()[pool[p]]);
+            m_fleet.push_back(phony_vehicle);
+        }
+        pgassert(is_feasible());
+        log << "\nRegret-" << k << " insertion: " << n_inserted << " of " << pool.size() << " orders inserted";
+    }
+
+}  //  namespace regret
+}  //  namespace initialsol
+}  //  namespace vrprouting
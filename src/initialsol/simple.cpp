@@ -26,13 +26,94 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "initialsol/simple.hpp"
 #include <deque>
 #include <algorithm>
+#include <iterator>
+#include <limits>
 #include <set>
+#include <vector>
 
 #include "cpp_common/assert.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "problem/matrix.hpp"
 #include "problem/node_types.hpp"
 #include "problem/orders.hpp"
 #include "problem/pickDeliver.hpp"
 
+namespace {
+
+/** The savings kept for each order, the most saving ones */
+const size_t savings_per_order = 50;
+
+/** @brief Travel time saved when order @b to is served after order @b from on the same route */
+struct Saving {
+    TInterval value;
+    size_t from;
+    size_t to;
+
+    /* the biggest saving goes first */
+    bool operator<(const Saving &rhs) const {
+        if (value != rhs.value) return value > rhs.value;
+        if (from != rhs.from) return from < rhs.from;
+        return to < rhs.to;
+    }
+};
+
+/** @brief Time windows data of a route of orders, each order served before the next one starts */
+struct Route_slack {
+    /** time of departure from the last delivery when the route starts at the vehicle's start */
+    TTimestamp ready;
+    /** latest arrival to the first pickup that keeps the route on time, ending on time at the vehicle's end */
+    TTimestamp latest;
+};
+
+/**
+ * @param [in] route the orders of the route
+ * @param [in] orders of the problem
+ * @param [in] vehicle the vehicle that gives the start, end and speed
+ * @returns the time windows data of the route
+ *
+ * The latest arrival is found from the end with the travel times at the latest departures:
+ * it is an estimation when the matrix is time dependent
+ */
+Route_slack
+route_slack(
+        const std::vector<size_t> &route,
+        const vrprouting::problem::Orders &orders,
+        const vrprouting::problem::Vehicle_pickDeliver &vehicle) {
+    using vrprouting::problem::Vehicle_node;
+    auto speed = vehicle.speed();
+    std::vector<const Vehicle_node*> nodes;
+    nodes.reserve(2 * route.size());
+    for (const auto o : route) {
+        nodes.push_back(&orders[o].pickup());
+        nodes.push_back(&orders[o].delivery());
+    }
+
+    Route_slack slack;
+    const Vehicle_node *prev = &vehicle.start_site();
+    slack.ready = prev->opens() + prev->service_time();
+    for (const auto node : nodes) {
+        auto arrival = slack.ready + prev->travel_time_to(*node, slack.ready, speed);
+        slack.ready = std::max(arrival, node->opens()) + node->service_time();
+        prev = node;
+    }
+
+    const auto &end = vehicle.end_site();
+    auto departure = end.closes() - prev->travel_time_to(end, end.closes(), speed);
+    slack.latest = (std::numeric_limits<TTimestamp>::min)();
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        auto arrival = std::min((*it)->closes(), departure - (*it)->service_time());
+        if (arrival < (*it)->opens()) return slack;
+        if (std::next(it) != nodes.rend()) {
+            departure = arrival - (*std::next(it))->travel_time_to(**it, arrival, speed);
+        } else {
+            slack.latest = arrival;
+        }
+    }
+    return slack;
+}
+
+}  // namespace
+
 namespace vrprouting {
 namespace initialsol {
 namespace simple {
@@ -52,7 +133,7 @@ Initial_solution::Initial_solution(
     unassigned(m_orders.size()),
     assigned() {
         invariant();
-        pgassert(kind >= OneTruck && kind <= OneDepot);
+        pgassert(kind >= OneTruck && kind <= Savings);
 
         switch (kind) {
             case OneTruck:
@@ -67,6 +148,9 @@ Initial_solution::Initial_solution(
             case OneDepot:
                 do_while_foo(kind);
                 break;
+            case Savings:
+                savings();
+                break;
             default: pgassert(false);
         }
 
@@ -117,6 +201,112 @@ Initial_solution::one_truck_all_orders() {
     invariant();
 }
 
+/**
+ * - Each order starts on its own route
+ * - The savings of serving an order after another one are computed using several threads,
+ *   each order keeps the savings_per_order biggest ones
+ * - From the biggest saving: the route that ends with the first order is joined with the route
+ *   that starts with the second order when the join arrives on time
+ * - Each route goes to a truck, the orders that do not fit on the truck and the orders that
+ *   do not fit on the first vehicle are inserted with BestInsert
+ *
+ * The orders of a route are served one after the other: the load never goes over the load of one order
+ */
+void
+Initial_solution::savings() {
+    invariant();
+    log << "\nInitial_solution::savings\n";
+    const auto &reference = vehicles().at(0);
+    auto speed = reference.speed();
+
+    std::vector<size_t> candidates;
+    for (const auto o : unassigned) {
+        if (reference.feasible_orders().has(o)) candidates.push_back(o);
+    }
+
+    /*
+     * savings of (candidate a) -> (candidate b)
+     */
+    std::vector<std::vector<Saving>> rows(candidates.size());
+    parallel_for(0, candidates.size(), 1, [&](size_t first, size_t last) {
+        for (auto a = first; a < last; ++a) {
+            const auto &delivery = m_orders[candidates[a]].delivery();
+            const auto &matrix = delivery.time_matrix();
+            auto to_end = matrix.at(delivery.matrix_idx(), reference.end_site().matrix_idx());
+            auto &row = rows[a];
+            for (size_t b = 0; b < candidates.size(); ++b) {
+                if (a == b) continue;
+                const auto &pickup = m_orders[candidates[b]].pickup();
+                if (!pickup.is_compatible_IJ(delivery, speed)) continue;
+                auto value = to_end
+                    + matrix.at(reference.start_site().matrix_idx(), pickup.matrix_idx())
+                    - matrix.at(delivery.matrix_idx(), pickup.matrix_idx());
+                if (value > 0) row.push_back({value, a, b});
+            }
+            if (row.size() > savings_per_order) {
+                std::partial_sort(row.begin(), row.begin() + savings_per_order, row.end());
+                row.resize(savings_per_order);
+            }
+        }
+    });
+
+    std::vector<Saving> all_savings;
+    for (auto &row : rows) {
+        all_savings.insert(all_savings.end(), row.begin(), row.end());
+        std::vector<Saving>().swap(row);
+    }
+    std::sort(all_savings.begin(), all_savings.end());
+
+    /*
+     * order -> its route, the routes have the orders
+     */
+    std::vector<size_t> route_of(m_orders.size());
+    std::vector<std::vector<size_t>> routes(candidates.size());
+    std::vector<Route_slack> slacks(candidates.size());
+    for (size_t a = 0; a < candidates.size(); ++a) {
+        route_of[candidates[a]] = a;
+        routes[a] = {candidates[a]};
+        slacks[a] = route_slack(routes[a], m_orders, reference);
+    }
+
+    for (const auto &saving : all_savings) {
+        auto r1 = route_of[candidates[saving.from]];
+        auto r2 = route_of[candidates[saving.to]];
+        if (r1 == r2) continue;
+        if (routes[r1].back() != candidates[saving.from] || routes[r2].front() != candidates[saving.to]) continue;
+
+        const auto &delivery = m_orders[candidates[saving.from]].delivery();
+        const auto &pickup = m_orders[candidates[saving.to]].pickup();
+        if (slacks[r1].ready + delivery.travel_time_to(pickup, slacks[r1].ready, speed) > slacks[r2].latest) continue;
+
+        for (const auto o : routes[r2]) route_of[o] = r1;
+        routes[r1].insert(routes[r1].end(), routes[r2].begin(), routes[r2].end());
+        routes[r2].clear();
+        slacks[r1] = route_slack(routes[r1], m_orders, reference);
+    }
+
+    for (const auto &route : routes) {
+        if (route.empty()) continue;
+        auto truck = vehicles().get_truck(route.front());
+        for (const auto o : route) {
+            const auto &order = m_orders[o];
+            if (!truck.feasible_orders().has(o)) continue;
+            truck.push_back(order);
+            if (!truck.is_feasible()) {
+                truck.erase(order);
+                continue;
+            }
+            assigned += o;
+            unassigned -= o;
+        }
+        if (truck.orders_size() > 0) m_fleet.push_back(truck);
+        invariant();
+    }
+
+    if (!unassigned.empty()) do_while_foo(BestInsert);
+    invariant();
+}
+
 void
 Initial_solution::do_while_feasible(
         problem::Vehicle_pickDeliver& vehicle,
@@ -48,6 +48,7 @@ process(
         double  factor,
         int     max_cycles,
         int64_t execution_date,
+        int     timeout,
 
         bool    check_triangle_inequality,
         int     subdivision_kind,
@@ -71,6 +72,7 @@ process(
             factor,
             max_cycles,
             execution_date,
+            timeout,
 
             check_triangle_inequality,
             subdivision_kind,
@@ -120,10 +122,11 @@ _vrp_optimize(PG_FUNCTION_ARGS) {
         PG_GETARG_FLOAT8(4),
         PG_GETARG_INT32(5),
         PG_GETARG_INT64(6),
+        PG_GETARG_INT32(7),
 
-        PG_GETARG_BOOL(7),
-        PG_GETARG_INT32(8),
-        PG_GETARG_BOOL(9),
+        PG_GETARG_BOOL(8),
+        PG_GETARG_INT32(9),
+        PG_GETARG_BOOL(10),
 
         &result_tuples,
         &result_count);
@@ -44,6 +44,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "cpp_common/messages.hpp"
 #include "cpp_common/orders_t.hpp"
 #include "cpp_common/short_vehicle.hpp"
+#include "cpp_common/time_limit.hpp"
 #include "cpp_common/vehicle_t.hpp"
 
 #include "initialsol/tabu.hpp"
@@ -66,6 +67,7 @@ using Short_vehicle = vrprouting::Short_vehicle;
  *  @param[in] matrix The unique time matrix
  *  @param[in] max_cycles number of cycles to perform during the optimization phase
  *  @param[in] execution_date Value used for not moving orders that are before this date
+ *  @param[in] time_limit When the time is over the optimization keeps the best solution found
  *
  *  @returns (vehicle id, stops vector) pair which hold the the new stops structure
  */
@@ -76,7 +78,8 @@ one_processing(
         const std::vector<Short_vehicle> &new_stops,
         const vrprouting::problem::Matrix &matrix,
         int max_cycles,
-        int64_t execution_date) {
+        int64_t execution_date,
+        const vrprouting::Time_limit &time_limit) {
     try {
         /*
          * Construct problem
@@ -107,7 +110,7 @@ one_processing(
          * - true:  optimize
          */
         using Optimize = vrprouting::optimizers::tabu::Optimize;
-        sol = Optimize(sol, static_cast<size_t>(max_cycles), false, true);
+        sol = Optimize(sol, static_cast<size_t>(max_cycles), false, true, time_limit);
 
         return sol.get_stops();
     } catch(...) {
@@ -189,6 +192,7 @@ update_stops(std::vector<Short_vehicle>& the_stops,  // NOLINT [runtime/referenc
  *  @param[in] max_cycles number of cycles to perform during the optimization phase
  *  @param[in] execution_date Value used for not moving orders that are before this date
  *  @param[in] subdivide_by_vehicle When true: incremental optimization based on vehicles. otherwise by orders
+ *  @param[in] time_limit When the time is over the optimizations keep the best solution found
  *  @param[in,out] log log of function
  *
  *  @returns (vehicle id, stops vector) pair which hold the the new stops structure
@@ -201,6 +205,7 @@ subdivide_processing(
         int max_cycles,
         int64_t execution_date,
         bool subdivide_by_vehicle,
+        const vrprouting::Time_limit &time_limit,
         std::ostringstream &log) {
     try {
         auto the_stops = get_initial_stops(vehicles);
@@ -268,7 +273,8 @@ subdivide_processing(
             auto new_stops = one_processing(
                     active_orders, active_vehicles, the_stops,
                     matrix,
-                    max_cycles, execution_date);
+                    max_cycles, execution_date,
+                    time_limit);
 
             update_stops(the_stops, new_stops);
         }
@@ -292,6 +298,7 @@ vrp_do_optimize(
         double factor,
         int max_cycles,
         int64_t execution_date,
+        int timeout,
 
         bool check_triangle_inequality,
         int subdivision_kind,
@@ -333,6 +340,12 @@ vrp_do_optimize(
         pgassert(*return_count == 0);
         pgassert(!(*return_tuples));
 
+        if (timeout < -1) {
+            *err_msg = to_pg_msg("Illegal value in parameter: timeout");
+            *log_msg = to_pg_msg("Expected value: timeout >= -1 (-1: no time limit)");
+            return;
+        }
+
         if (subdivision_kind < 0 || subdivision_kind > 2) {
             *notice_msg = to_pg_msg("Illegal value in parameter: subdivision_kind");
             *log_msg = to_pg_msg("Expected value: 0 <= subdivision_kind < 2");
@@ -351,6 +364,11 @@ vrp_do_optimize(
             return;
         }
 
+        /*
+         * the time given starts now
+         */
+        vrprouting::Time_limit time_limit(timeout);
+
         /*
 	 * Data input starts
          */
@@ -502,11 +520,13 @@ vrp_do_optimize(
                     matrix,
                     max_cycles, execution_date,
                     subdivide_by_vehicle,
+                    time_limit,
                     log) :
             one_processing(
                     orders, vehicles, {},
                     matrix,
-                    max_cycles, execution_date);
+                    max_cycles, execution_date,
+                    time_limit);
 
         /*
          * Prepare results
@@ -0,0 +1,514 @@
+/*PGR-GNU*****************************************************************
+
+FILE: alns.cpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#include "optimizers/alns.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cpp_common/assert.hpp"
+#include "cpp_common/interruption.hpp"
+#include "cpp_common/messages.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "initialsol/regret.hpp"
+#include "problem/matrix.hpp"
+
+namespace vrprouting {
+namespace optimizers {
+namespace alns {
+
+/**
+ * @param [in] random number in [0, 1)
+ * @returns the position of the operator chosen
+ */
+size_t
+Optimize::Weights::select(double random) const {
+    double total = 0;
+    for (const auto w : weight) total += w;
+
+    auto target = random * total;
+    for (size_t i = 0; i < weight.size(); ++i) {
+        if (target < weight[i]) return i;
+        target -= weight[i];
+    }
+    return weight.size() - 1;
+}
+
+/**
+ * The operators that were not used keep their weight
+ *
+ * @param [in] reaction 0: the weights do not change, 1: the weights are the average scores
+ * @param [in] floor smallest weight
+ */
+void
+Optimize::Weights::update(double reaction, double floor) {
+    for (size_t i = 0; i < weight.size(); ++i) {
+        if (uses[i] > 0) {
+            weight[i] = std::max(floor,
+                    (1 - reaction) * weight[i] + reaction * score[i] / static_cast<double>(uses[i]));
+        }
+        score[i] = 0;
+        uses[i] = 0;
+    }
+}
+
+/**
+ * - The unassigned orders leave the phony vehicles
+ * - The search works with the real vehicles
+ * - The orders that are unassigned on the best solution go back to phony vehicles, one order per vehicle
+ *
+ * @param [in] old_solution - solution to be optimized
+ * @param [in] max_cycles - number of cycles of iterations_per_cycle iterations
+ * @param [in] stop_on_all_served - a stopping condition: stop when all orders are served
+ * @param [in] optimize - a stopping condition when @b false: only add orders; do not optimize
+ * @param [in] time_limit - a stopping condition: stop when the time is over
+ * @param [in] threads - maximum number of threads that evaluate the vehicles, 1: no worker threads
+ * @post this solution's fleet has the best solution found
+ */
+Optimize::Optimize(
+        const problem::Solution &old_solution,
+        size_t max_cycles,
+        bool stop_on_all_served,
+        bool optimize,
+        const Time_limit &time_limit,
+        size_t threads) :
+        problem::Solution(old_solution),
+        m_max_cycles(max_cycles),
+        m_stop_on_all_served(stop_on_all_served),
+        m_optimize(optimize),
+        m_time_limit(time_limit),
+        m_threads(threads) {
+    ENTERING(log);
+    for (const auto &vehicle : m_fleet) {
+        if (vehicle.is_phony()) m_unassigned += vehicle.orders_in_vehicle();
+    }
+    m_fleet.erase(std::remove_if(
+            m_fleet.begin(),
+            m_fleet.end(),
+            [](const problem::Vehicle_pickDeliver &v){return v.is_phony();}),
+            m_fleet.end());
+    m_is_changed.assign(m_fleet.size(), false);
+
+    /*
+     * this function does the actual work
+     */
+    alns_search();
+
+    restore_best();
+    for (const auto o_id : m_unassigned) {
+        auto phony_vehicle = vehicles().get_phony();
+        phony_vehicle.push_back(orders()[o_id]);
+        m_fleet.push_back(phony_vehicle);
+    }
+
+    log << tau("Best solution found");
+    EXITING(log);
+}
+
+/**
+ * It searches until either (terminating conditions):
+ * 1. all the iterations are done
+ * 2. all possible orders are served without optimization and optimize is set to false
+ * 3. all orders are served and stop_on_all_served is set to true
+ * 4. the time is over
+ * 5. no order is on a real vehicle
+ */
+void
+Optimize::alns_search() {
+    ENTERING(log);
+    first_solution();
+    save_best();
+    log << "\nFirst solution: " << m_best.cost.unassigned << " unassigned orders, travel time "
+        << m_best.cost.travel_time;
+
+    if (!m_optimize) return;
+
+    auto iterations = m_max_cycles * iterations_per_cycle;
+    auto current = m_best.cost;
+    auto temperature = start_worsening * static_cast<double>(current.travel_time) / -std::log(start_probability);
+    auto cooling = iterations > 0 ? std::pow(end_temperature, 1.0 / static_cast<double>(iterations)) : 1.0;
+
+    size_t i = 0;
+    for (; i < iterations; ++i) {
+        if (m_stop_on_all_served && m_best.unassigned.empty()) break;
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) {
+            log << "\nTime limit reached on iteration " << i;
+            break;
+        }
+
+        size_t assigned = 0;
+        for (const auto &vehicle : m_fleet) assigned += vehicle.orders_size();
+        if (assigned == 0) break;
+
+        auto fewest = std::min(min_removed, assigned);
+        auto most = std::max(fewest, std::min({max_removed, assigned,
+                    static_cast<size_t>(max_removed_fraction * static_cast<double>(assigned))}));
+        auto q = fewest + random_index(most - fewest + 1);
+
+        auto r = m_ruin_weights.select(random01());
+        auto c = m_recreate_weights.select(random01());
+
+        m_prev_unassigned = m_unassigned;
+        ruin(static_cast<Ruin>(r), q);
+        recreate(static_cast<Recreate>(c));
+
+        /*
+         * acceptance: less unassigned orders is better,
+         * with the same number of unassigned orders, simulated annealing on the travel time
+         */
+        auto cost = current_cost();
+        bool accepted = false;
+        double score = 0;
+        if (cost < m_best.cost) {
+            accepted = true;
+            score = score_best;
+        } else if (cost.unassigned != current.unassigned) {
+            accepted = cost.unassigned < current.unassigned;
+            score = score_better;
+        } else {
+            auto delta = static_cast<double>(cost.travel_time - current.travel_time);
+            if (delta < 0) {
+                accepted = true;
+                score = score_better;
+            } else {
+                accepted = delta == 0 || (temperature > 0 && random01() < std::exp(-delta / temperature));
+                score = score_accepted;
+            }
+        }
+
+        if (accepted) {
+            auto hash = solution_hash();
+            if (score != score_best && m_visited.has(hash)) score = 0;
+            m_visited.insert(hash);
+            accept();
+            current = cost;
+            if (cost < m_best.cost) {
+                save_best();
+                log << "\n\t***  best on iteration " << i << ": " << cost.unassigned
+                    << " unassigned orders, travel time " << cost.travel_time;
+            }
+        } else {
+            score = 0;
+            reject();
+        }
+
+        m_ruin_weights.score[r] += score;
+        ++m_ruin_weights.uses[r];
+        m_recreate_weights.score[c] += score;
+        ++m_recreate_weights.uses[c];
+        if ((i + 1) % segment_length == 0) {
+            m_ruin_weights.update(reaction, min_weight);
+            m_recreate_weights.update(reaction, min_weight);
+        }
+
+        temperature *= cooling;
+    }
+    log << "\nIterations done: " << i;
+    EXITING(log);
+}
+
+/**
+ * The unassigned orders, in the order of their index, go to the vehicle that increases less the travel time.
+ * The vehicles are evaluated using several threads.
+ */
+void
+Optimize::first_solution() {
+    auto unassigned = m_unassigned;
+    std::vector<TInterval> delta(m_fleet.size());
+    for (const auto o_id : unassigned) {
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) break;
+
+        parallel_for(0, m_fleet.size(), vehicles_per_thread, [&](size_t first, size_t last) {
+            for (auto v = first; v < last; ++v) {
+                delta[v] = m_fleet[v].feasible_orders().has(o_id) ?
+                    m_fleet[v].insertion_delta(orders()[o_id]) : problem::Vehicle_pickDeliver::infeasible_delta;
+            }
+        }, m_threads);
+
+        auto best = static_cast<size_t>(std::min_element(delta.begin(), delta.end()) - delta.begin());
+        if (best == m_fleet.size() || delta[best] == problem::Vehicle_pickDeliver::infeasible_delta) continue;
+
+        m_fleet[best].hillClimb(orders()[o_id]);
+        pgassert(m_fleet[best].has_order(orders()[o_id]));
+        m_unassigned -= o_id;
+    }
+}
+
+/**
+ * @param [in] kind of ruin
+ * @param [in] q number of orders to remove
+ */
+void
+Optimize::ruin(Ruin kind, size_t q) {
+    switch (kind) {
+        case kRandomRemoval:
+            random_removal(q);
+            break;
+        case kRelatedRemoval:
+            related_removal(q);
+            break;
+        case kWorstRemoval:
+            worst_removal(q);
+            break;
+        case kRouteRemoval:
+            route_removal(q);
+            break;
+        case kRuins:
+            break;
+    }
+}
+
+/**
+ * Removes orders chosen at random
+ */
+void
+Optimize::random_removal(size_t q) {
+    std::vector<std::pair<size_t, size_t>> assigned;
+    for (size_t v = 0; v < m_fleet.size(); ++v) {
+        for (const auto o_id : m_fleet[v].orders_in_vehicle()) assigned.emplace_back(v, o_id);
+    }
+
+    for (size_t k = 0; k < q && !assigned.empty(); ++k) {
+        auto i = random_index(assigned.size());
+        remove_order(assigned[i].first, assigned[i].second);
+        assigned[i] = assigned.back();
+        assigned.pop_back();
+    }
+}
+
+/**
+ * Removes an order chosen at random and orders related to the ones removed:
+ * - an order already removed is chosen at random
+ * - the order to remove is chosen from the list of the other orders sorted by relatedness,
+ *   the first ones of the list are chosen more often
+ */
+void
+Optimize::related_removal(size_t q) {
+    auto vehicle_of = vehicle_of_orders();
+    std::vector<size_t> candidates;
+    for (size_t o_id = 0; o_id < vehicle_of.size(); ++o_id) {
+        if (vehicle_of[o_id] < m_fleet.size()) candidates.push_back(o_id);
+    }
+    if (candidates.empty()) return;
+
+    std::vector<size_t> removed;
+    auto i = random_index(candidates.size());
+    removed.push_back(candidates[i]);
+    candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(i));
+
+    std::vector<std::pair<TInterval, size_t>> ranked;
+    while (removed.size() < q && !candidates.empty()) {
+        auto seed = removed[random_index(removed.size())];
+        ranked.clear();
+        for (const auto o_id : candidates) ranked.emplace_back(relatedness(seed, o_id), o_id);
+
+        auto k = std::min(ranked.size() - 1,
+                static_cast<size_t>(std::pow(random01(), related_determinism) * static_cast<double>(ranked.size())));
+        std::nth_element(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(k), ranked.end());
+        auto chosen = ranked[k].second;
+        removed.push_back(chosen);
+        candidates.erase(std::find(candidates.begin(), candidates.end(), chosen));
+    }
+
+    for (const auto o_id : removed) remove_order(vehicle_of[o_id], o_id);
+}
+
+/**
+ * Removes the orders whose removal decreases more the travel time of their vehicles:
+ * - the decrease of each order is evaluated on the current routes, using several threads
+ * - the order to remove is chosen from the list sorted by decrease,
+ *   the first ones of the list are chosen more often
+ */
+void
+Optimize::worst_removal(size_t q) {
+    std::vector<std::vector<std::pair<TInterval, size_t>>> savings(m_fleet.size());
+    parallel_for(0, m_fleet.size(), vehicles_per_thread, [&](size_t first, size_t last) {
+        for (auto v = first; v < last; ++v) {
+            auto &vehicle = m_fleet[v];
+            if (vehicle.orders_size() == 0) continue;
+            auto route = vehicle.route();
+            auto travel_time = vehicle.total_travel_time();
+            for (const auto o_id : route.orders_in_vehicle) {
+                vehicle.erase(orders()[o_id]);
+                savings[v].emplace_back(travel_time - vehicle.total_travel_time(), o_id);
+                vehicle.set_route(route);
+            }
+        }
+    }, m_threads);
+
+    /* (saving, order, vehicle) largest savings first */
+    std::vector<std::tuple<TInterval, size_t, size_t>> ranked;
+    for (size_t v = 0; v < m_fleet.size(); ++v) {
+        for (const auto &s : savings[v]) ranked.emplace_back(-s.first, s.second, v);
+    }
+    std::sort(ranked.begin(), ranked.end());
+
+    for (size_t k = 0; k < q && !ranked.empty(); ++k) {
+        auto i = std::min(ranked.size() - 1,
+                static_cast<size_t>(std::pow(random01(), worst_determinism) * static_cast<double>(ranked.size())));
+        remove_order(std::get<2>(ranked[i]), std::get<1>(ranked[i]));
+        ranked.erase(ranked.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
+/**
+ * Removes all the orders of routes chosen at random, until at least @b q orders are removed
+ */
+void
+Optimize::route_removal(size_t q) {
+    std::vector<size_t> routes;
+    for (size_t v = 0; v < m_fleet.size(); ++v) {
+        if (m_fleet[v].orders_size() > 0) routes.push_back(v);
+    }
+
+    size_t removed = 0;
+    while (removed < q && !routes.empty()) {
+        auto i = random_index(routes.size());
+        auto v = routes[i];
+        routes[i] = routes.back();
+        routes.pop_back();
+        for (const auto o_id : m_fleet[v].orders_in_vehicle()) {
+            remove_order(v, o_id);
+            ++removed;
+        }
+    }
+}
+
+/**
+ * All the unassigned orders are candidates, also the ones that were unassigned before the ruin.
+ *
+ * - greedy: regret-1 insertion, the order whose insertion costs less is inserted first
+ * - regret: regret-2 insertion, the order with the largest difference between its best and second best vehicle
+ *   is inserted first, orders that fit on only one vehicle go first.
+ *
+ * @param [in] kind of recreate
+ */
+void
+Optimize::recreate(Recreate kind) {
+    std::vector<size_t> pool(m_unassigned.begin(), m_unassigned.end());
+    if (pool.empty()) return;
+
+    size_t k = kind == kGreedyInsertion ? 1 : 2;
+    auto inserted = initialsol::regret::Insertion(m_fleet, orders(), k, m_time_limit, m_threads)
+        .insert(pool, [&](size_t v) {touch(v);});
+
+    for (size_t p = 0; p < pool.size(); ++p) {
+        if (inserted[p]) m_unassigned -= pool[p];
+    }
+}
+
+/**
+ * The travel time between the pickups and between the deliveries,
+ * plus the difference between the opening times of the pickups and of the deliveries
+ */
+TInterval
+Optimize::relatedness(size_t o_id1, size_t o_id2) const {
+    const auto &order1 = orders()[o_id1];
+    const auto &order2 = orders()[o_id2];
+    const auto &matrix = order1.pickup().time_matrix();
+    return matrix.at(order1.pickup().matrix_idx(), order2.pickup().matrix_idx())
+        + matrix.at(order1.delivery().matrix_idx(), order2.delivery().matrix_idx())
+        + std::abs(order1.pickup().opens() - order2.pickup().opens())
+        + std::abs(order1.delivery().opens() - order2.delivery().opens());
+}
+
+void
+Optimize::remove_order(size_t v, size_t o_id) {
+    touch(v);
+    m_fleet[v].erase(orders()[o_id]);
+    m_unassigned += o_id;
+}
+
+void
+Optimize::touch(size_t v) {
+    if (m_is_changed[v]) return;
+    m_is_changed[v] = true;
+    m_changed.emplace_back(v, m_fleet[v].route());
+}
+
+void
+Optimize::accept() {
+    for (const auto &changed : m_changed) m_is_changed[changed.first] = false;
+    m_changed.clear();
+}
+
+void
+Optimize::reject() {
+    for (const auto &changed : m_changed) {
+        m_fleet[changed.first].set_route(changed.second);
+        m_is_changed[changed.first] = false;
+    }
+    m_changed.clear();
+    m_unassigned = m_prev_unassigned;
+}
+
+std::vector<size_t>
+Optimize::vehicle_of_orders() const {
+    std::vector<size_t> vehicle_of(orders().size(), m_fleet.size());
+    for (size_t v = 0; v < m_fleet.size(); ++v) {
+        for (const auto o_id : m_fleet[v].orders_in_vehicle()) vehicle_of[o_id] = v;
+    }
+    return vehicle_of;
+}
+
+Optimize::Cost
+Optimize::current_cost() const {
+    TInterval travel_time = 0;
+    for (const auto &vehicle : m_fleet) travel_time += vehicle.total_travel_time();
+    return {m_unassigned.size(), travel_time};
+}
+
+uint64_t
+Optimize::solution_hash() const {
+    uint64_t hash = 0;
+    for (const auto &vehicle : m_fleet) hash = hash_combine(hash, vehicle.path_hash());
+    return hash;
+}
+
+void
+Optimize::save_best() {
+    m_best.routes.clear();
+    m_best.routes.reserve(m_fleet.size());
+    for (const auto &vehicle : m_fleet) m_best.routes.push_back(vehicle.route());
+    m_best.unassigned = m_unassigned;
+    m_best.cost = current_cost();
+}
+
+void
+Optimize::restore_best() {
+    for (size_t v = 0; v < m_fleet.size(); ++v) m_fleet[v].set_route(m_best.routes[v]);
+    m_unassigned = m_best.unassigned;
+}
+
+}  //  namespace alns
+}  //  namespace optimizers
+}  //  namespace vrprouting
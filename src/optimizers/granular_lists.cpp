@@ -0,0 +1,156 @@
+/*PGR-GNU*****************************************************************
+
+FILE: granular_lists.cpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#include "optimizers/granular_lists.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "cpp_common/parallel_for.hpp"
+#include "problem/matrix.hpp"
+#include "problem/orders.hpp"
+#include "problem/order.hpp"
+#include "problem/vehicle_pickDeliver.hpp"
+
+namespace vrprouting {
+namespace optimizers {
+namespace tabu {
+
+/**
+ * @param [in] vehicle the route
+ * @param [in] order the order
+ * @returns the smallest distance between the order and a node of the route
+ */
+TInterval
+Granular_lists::distance(const problem::Vehicle_pickDeliver &vehicle, const problem::Order &order) {
+    const auto &pickup = order.pickup();
+    const auto &delivery = order.delivery();
+    const auto &matrix = pickup.time_matrix();
+
+    auto best = (std::numeric_limits<TInterval>::max)();
+    for (size_t i = 0; i < vehicle.size(); ++i) {
+        const auto &node = vehicle.at(i);
+        auto travel_time = std::min(
+                matrix.at(node.matrix_idx(), pickup.matrix_idx()),
+                matrix.at(delivery.matrix_idx(), node.matrix_idx()));
+        auto gap = std::max({TInterval(0), node.opens() - delivery.closes(), pickup.opens() - node.closes()});
+        best = std::min(best, travel_time + gap);
+    }
+    return best;
+}
+
+/**
+ * - The distances are computed for the real vehicles whose route changed
+ * - The distances of the routes that are no longer on the fleet are forgotten
+ * - When the routes changed, the lists of all the orders are built again
+ *
+ * @param [in] fleet the vehicles of the solution
+ * @param [in] orders the orders of the problem
+ * @param [in] threads maximum number of threads that compute the distances
+ */
+void
+Granular_lists::update(
+        const std::deque<problem::Vehicle_pickDeliver> &fleet,
+        const problem::Orders &orders,
+        size_t threads) {
+    std::vector<const problem::Vehicle_pickDeliver*> routes;
+    std::unordered_set<uint64_t> keys;
+    for (const auto &vehicle : fleet) {
+        if (vehicle.is_phony()) continue;
+        if (keys.insert(vehicle.route_hash()).second) routes.push_back(&vehicle);
+    }
+
+    auto same_routes = m_near_orders.size() == routes.size()
+        && std::all_of(routes.begin(), routes.end(), [&](const problem::Vehicle_pickDeliver *vehicle) {
+                return m_near_orders.count(vehicle->route_hash()) > 0;
+                });
+    if (same_routes) return;
+
+    for (auto it = m_distances.begin(); it != m_distances.end(); ) {
+        it = keys.count(it->first) ? std::next(it) : m_distances.erase(it);
+    }
+
+    std::vector<const problem::Vehicle_pickDeliver*> changed;
+    for (const auto vehicle : routes) {
+        if (!m_distances.count(vehicle->route_hash())) changed.push_back(vehicle);
+    }
+
+    std::vector<std::vector<TInterval>> rows(changed.size());
+    parallel_for(0, changed.size(), 1, [&](size_t first, size_t last) {
+        for (auto v = first; v < last; ++v) {
+            rows[v].resize(orders.size());
+            for (size_t o = 0; o < orders.size(); ++o) {
+                rows[v][o] = distance(*changed[v], orders[o]);
+            }
+        }
+    }, threads);
+    for (size_t v = 0; v < changed.size(); ++v) {
+        m_distances[changed[v]->route_hash()] = std::move(rows[v]);
+    }
+
+    /*
+     * the k nearest vehicles of each order
+     */
+    m_near_orders.clear();
+    for (const auto vehicle : routes) m_near_orders[vehicle->route_hash()] = Dynamic_bitset(orders.size());
+    m_none = Dynamic_bitset(orders.size());
+
+    auto k = std::min(m_k, routes.size());
+    if (k == 0) return;
+
+    std::vector<const std::vector<TInterval>*> distances;
+    distances.reserve(routes.size());
+    for (const auto vehicle : routes) distances.push_back(&m_distances.at(vehicle->route_hash()));
+
+    /* distance, vehicle idx, route */
+    std::vector<std::tuple<TInterval, size_t, uint64_t>> nearest(routes.size());
+    for (size_t o = 0; o < orders.size(); ++o) {
+        for (size_t v = 0; v < routes.size(); ++v) {
+            nearest[v] = std::make_tuple((*distances[v])[o], routes[v]->idx(), routes[v]->route_hash());
+        }
+        std::nth_element(nearest.begin(), nearest.begin() + static_cast<std::ptrdiff_t>(k - 1), nearest.end());
+        for (size_t v = 0; v < k; ++v) m_near_orders[std::get<2>(nearest[v])].set(o);
+    }
+}
+
+/**
+ * @param [in] vehicle the vehicle
+ * @returns the orders that have the vehicle on their list
+ */
+const Dynamic_bitset&
+Granular_lists::near_orders(const problem::Vehicle_pickDeliver &vehicle) const {
+    auto it = m_near_orders.find(vehicle.route_hash());
+    return it == m_near_orders.end() ? m_none : it->second;
+}
+
+}  // namespace tabu
+}  // namespace optimizers
+}  // namespace vrprouting
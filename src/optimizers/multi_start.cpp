@@ -0,0 +1,271 @@
+/*PGR-GNU*****************************************************************
+
+FILE: multi_start.cpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#include "optimizers/multi_start.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cpp_common/assert.hpp"
+#include "cpp_common/interruption.hpp"
+#include "cpp_common/messages.hpp"
+#include "optimizers/tabu.hpp"
+
+namespace vrprouting {
+namespace optimizers {
+namespace tabu {
+
+Incumbent::Incumbent(size_t trajectories) :
+    m_active(trajectories),
+    m_roles(trajectories, kContinue),
+    m_final(trajectories) {
+}
+
+/**
+ * @param [in] solution of the trajectory
+ * @param [in] trajectory number of the trajectory
+ * @returns the key of the solution
+ */
+Incumbent::Key
+Incumbent::key(const problem::Solution &solution, size_t trajectory) {
+    size_t unassigned = 0;
+    for (const auto &vehicle : solution.fleet()) {
+        if (vehicle.is_phony()) unassigned += vehicle.orders_size();
+    }
+    return {unassigned, solution.objective(), trajectory};
+}
+
+/**
+ * - First part: the trajectories give their keys and get their roles
+ * - The trajectory that gives its solution copies it, outside the lock
+ * - Second part: the trajectories wait until the solution was given
+ *
+ * @returns a copy of the incumbent for the trajectory that restarts, @b nullptr for the others
+ */
+std::unique_ptr<problem::Solution>
+Incumbent::exchange(const Key &key, const std::function<problem::Solution()> &best) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_keys.push_back(key);
+    wait_others(lock);
+    if (m_cancelled) return nullptr;
+
+    auto role = m_roles[key.trajectory];
+    if (role == kGive) {
+        lock.unlock();
+        auto solution = std::make_unique<problem::Solution>(best());
+        lock.lock();
+        m_solution = std::move(solution);
+        m_key = key;
+    }
+
+    wait_others(lock);
+    if (m_cancelled || role != kRestart) return nullptr;
+    return std::make_unique<problem::Solution>(*m_solution);
+}
+
+/**
+ * The solution becomes the incumbent when it is better
+ */
+void
+Incumbent::leave(const problem::Solution &solution, size_t trajectory) {
+    auto final_solution = std::make_unique<problem::Solution>(solution);
+    auto final_key = key(solution, trajectory);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_solution || final_key < m_key) {
+        m_solution = std::make_unique<problem::Solution>(solution);
+        m_key = final_key;
+    }
+    m_final[trajectory] = std::move(final_solution);
+    --m_active;
+    if (m_active > 0 && m_arrived == m_active) next_generation();
+    m_condition.notify_all();
+}
+
+void
+Incumbent::leave(size_t) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_active;
+    if (m_active > 0 && m_arrived == m_active) next_generation();
+    m_condition.notify_all();
+}
+
+void
+Incumbent::cancel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancelled = true;
+    m_condition.notify_all();
+}
+
+bool
+Incumbent::wait_all(std::chrono::milliseconds time) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_condition.wait_for(lock, time, [this] {return m_active == 0;});
+}
+
+/**
+ * The key of each solution is computed again: the ties are broken by the number of the trajectory
+ */
+const problem::Solution*
+Incumbent::best() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const problem::Solution *best = nullptr;
+    Key best_key {0, 0, 0};
+    for (size_t t = 0; t < m_final.size(); ++t) {
+        if (!m_final[t]) continue;
+        auto k = key(*m_final[t], t);
+        if (!best || k < best_key) {
+            best = m_final[t].get();
+            best_key = k;
+        }
+    }
+    return best;
+}
+
+void
+Incumbent::wait_others(std::unique_lock<std::mutex> &lock) {
+    auto generation = m_generation;
+    if (++m_arrived == m_active) {
+        next_generation();
+        return;
+    }
+    m_condition.wait(lock, [&] {return m_generation != generation || m_cancelled;});
+}
+
+void
+Incumbent::next_generation() {
+    if (!m_second_part) assign_roles();
+    m_second_part = !m_second_part;
+    m_arrived = 0;
+    ++m_generation;
+    m_condition.notify_all();
+}
+
+/**
+ * - the best trajectory of the meeting gives its solution when it is better than the incumbent
+ * - the worst trajectory of the meeting restarts when the incumbent has less unassigned orders
+ *   or an objective restart_gap smaller
+ * - trajectory 0 never restarts: the result is not worse than the one of the single tabu search
+ */
+void
+Incumbent::assign_roles() {
+    std::fill(m_roles.begin(), m_roles.end(), kContinue);
+    if (m_keys.empty()) return;
+
+    auto best = *std::min_element(m_keys.begin(), m_keys.end());
+    auto worst = best;
+    for (const auto &k : m_keys) {
+        if (k.trajectory != 0 && worst < k) worst = k;
+    }
+    m_keys.clear();
+
+    auto incumbent = m_key;
+    if (!m_solution || best < m_key) {
+        m_roles[best.trajectory] = kGive;
+        incumbent = best;
+    }
+
+    if (worst.trajectory == best.trajectory) return;
+    if (worst.unassigned > incumbent.unassigned
+            || (worst.unassigned == incumbent.unassigned
+                && incumbent.objective < worst.objective * (1 - restart_gap))) {
+        m_roles[worst.trajectory] = kRestart;
+    }
+}
+
+/**
+ * @param [in] solution - solution to be optimized
+ * @param [in] max_cycles - number of times to perform a single tabu search (optimization) cycle
+ * @param [in] stop_on_all_served - a stopping condition: stop when all orders are served
+ * @param [in] optimize - a stopping condition when @b false: only add orders; do not optimize
+ * @param [in] time_limit - a stopping condition: stop when the time is over
+ * @param [in] threads - number of trajectories
+ * @post this solution is the best solution found
+ */
+Multi_start::Multi_start(
+        const problem::Solution &solution,
+        size_t max_cycles,
+        bool stop_on_all_served,
+        bool optimize,
+        const Time_limit &time_limit,
+        size_t threads) :
+        problem::Solution(solution) {
+    pgassert(threads > 0);
+    Incumbent incumbent(threads);
+    Time_limit limit(time_limit, incumbent.cancelled());
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto run = [&](size_t t) {
+        try {
+            /* the trajectories use the threads: each one evaluates its moves on its own thread */
+            Optimize trajectory(solution, max_cycles, stop_on_all_served, optimize, limit, 1, t, &incumbent);
+            incumbent.leave(trajectory, t);
+        } catch (...) {
+            errors[t] = std::current_exception();
+            incumbent.cancel();
+            incumbent.leave(t);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    size_t t = 0;
+    try {
+        for (; t < threads; ++t) workers.emplace_back(run, t);
+    } catch (...) {
+        /* could not create more threads: the remaining trajectories do not start */
+        for (auto pending = t; pending < threads; ++pending) incumbent.leave(pending);
+    }
+
+    if (workers.empty()) {
+        problem::Solution::operator=(Optimize(solution, max_cycles, stop_on_all_served, optimize, time_limit));
+        return;
+    }
+
+    /*
+     * the trajectories can not be interrupted: they are cancelled and the interruption happens after they end
+     */
+    while (!incumbent.wait_all(check_period)) {
+        if (INTERRUPTS_PENDING_CONDITION()) incumbent.cancel();
+    }
+    for (auto &worker : workers) worker.join();
+    CHECK_FOR_INTERRUPTS();
+
+    for (const auto &e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    auto best = incumbent.best();
+    pgassert(best);
+    problem::Solution::operator=(*best);
+    log << "\nBest solution of " << workers.size() << " trajectories";
+}
+
+}  //  namespace tabu
+}  //  namespace optimizers
+}  //  namespace vrprouting
@@ -30,9 +30,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "cpp_common/assert.hpp"
+#include "cpp_common/interruption.hpp"
 
 namespace vrprouting {
 namespace optimizers {
@@ -42,10 +46,12 @@ namespace simple {
 Optimize::Optimize(
         const problem::Solution &old_solution,
         size_t times,
-        const Initials_code& p_kind) :
+        const Initials_code& p_kind,
+        const Time_limit &time_limit) :
     problem::Solution(old_solution),
     best_solution(old_solution),
-    m_kind(p_kind) {
+    m_kind(p_kind),
+    m_time_limit(time_limit) {
         inter_swap(times);
         this->m_fleet = best_solution.fleet();
         log << tau("bestSol before sort by size");
@@ -67,10 +73,17 @@ Optimize::inter_swap(size_t times) {
 
     size_t i = 0;
     while (i++ < times) {
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) {
+            log << "\nTime limit reached on cycle " << i;
+            break;
+        }
         log << "\n*************************** CYCLE" << i;
         inter_swap();
         log << tau("after inter swap");
-        std::rotate(m_fleet.begin(), m_fleet.begin() + 1, m_fleet.end());
+        /* rotating: only the first vehicle is moved */
+        m_fleet.push_back(std::move(m_fleet.front()));
+        m_fleet.pop_front();
         log << tau("before next cycle");
     }
 }
@@ -93,6 +106,8 @@ Optimize::inter_swap() {
      *   .. to ... from ....
      */
     for (auto &from : m_fleet) {
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) break;
         for (auto &to : m_fleet) {
             if (&from == &to) break;
 
@@ -339,15 +354,20 @@ Optimize::sort_by_id() {
             });
 }
 
+/*
+ * The positions of the vehicles are sorted, the vehicles are moved once at the end
+ */
 void
 Optimize::sort_by_size() {
-    sort_by_duration();
-    std::stable_sort(m_fleet.begin(), m_fleet.end(), []
-            (const problem::Vehicle_pickDeliver &lhs, const problem::Vehicle_pickDeliver &rhs)
-            -> bool {
-            return lhs.orders_in_vehicle().size()
-            > rhs.orders_in_vehicle().size();
+    std::vector<size_t> positions(m_fleet.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    std::sort(positions.begin(), positions.end(), [&](size_t lhs, size_t rhs) -> bool {
+            return m_fleet[lhs].duration() > m_fleet[rhs].duration();
+            });
+    std::stable_sort(positions.begin(), positions.end(), [&](size_t lhs, size_t rhs) -> bool {
+            return m_fleet[lhs].orders_size() > m_fleet[rhs].orders_size();
             });
+    arrange_fleet(positions);
 }
 
 void
@@ -534,6 +554,8 @@ void
 Optimize::decrease_truck() {
     bool decreased(false);
     for (size_t i = 1; i < m_fleet.size(); ++i) {
+        CHECK_FOR_INTERRUPTS();
+        if (m_time_limit.reached()) break;
         decreased = decrease_truck(i) || decreased;
     }
     if (decreased) {
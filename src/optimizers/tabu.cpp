@@ -29,13 +29,22 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "optimizers/tabu.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
 #include <string>
 #include <deque>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
 
 #include "cpp_common/assert.hpp"
+#include "cpp_common/interruption.hpp"
 #include "cpp_common/messages.hpp"
+#include "cpp_common/parallel_for.hpp"
 
 #include "optimizers/move.hpp"
+#include "optimizers/multi_start.hpp"
 
 /**
  * Anonymus namespace for static functions
@@ -63,6 +72,23 @@ bool
 are_all_served(const Identifiers<size_t> &unassigned) {
     return unassigned.empty();
 }
+
+/** @brief Looks for a result on a memo
+ *
+ * @returns false when the key is not on the memo
+ * @returns true when the key is on the memo, the result is copied
+ * @param [in] memo the results
+ * @param [in] key of the result
+ * @param [out] result the result found
+ */
+template <typename Memo, typename Result>
+bool
+find_result(const Memo &memo, size_t key, Result &result) {
+    auto it = memo.find(key);
+    if (it == memo.end()) return false;
+    result = it->second;
+    return true;
+}
 }  // namespace
 
 namespace vrprouting {
@@ -90,19 +116,66 @@ digraph G {
  * @param [in] max_cycles - number of times to perform a single tabu search (optimization) cycle
  * @param [in] stop_on_all_served - a stopping condition: stop when all orders are served
  * @param [in] optimize - a stopping condition when @b false: only add orders; do not optimize
+ * @param [in] time_limit - a stopping condition: stop when the time is over
+ * @param [in] threads - maximum number of threads that evaluate a neighbourhood, 1: no worker threads
+ * @post this solution's fleet has the best solution found
+ */
+Optimize::Optimize(
+        const problem::Solution &old_solution,
+        size_t max_cycles,
+        bool stop_on_all_served,
+        bool optimize,
+        const Time_limit &time_limit,
+        size_t threads) :
+        Optimize(old_solution, max_cycles, stop_on_all_served, optimize, time_limit, threads, 0, nullptr) {
+}
+
+/**
+ * The trajectories differ on:
+ * - the order in which the unassigned orders are inserted
+ * - the length of the tabu list
+ *
+ * Every exchange_cycles cycles the trajectory meets the other trajectories on the incumbent.
+ *
+ * @param [in] old_solution - solution to be optimized
+ * @param [in] max_cycles - number of times to perform a single tabu search (optimization) cycle
+ * @param [in] stop_on_all_served - a stopping condition: stop when all orders are served
+ * @param [in] optimize - a stopping condition when @b false: only add orders; do not optimize
+ * @param [in] time_limit - a stopping condition: stop when the time is over
+ * @param [in] threads - maximum number of threads that evaluate a neighbourhood, 1: no worker threads
+ * @param [in] trajectory - number of the trajectory, trajectory 0 is the single search
+ * @param [in] incumbent - best solution shared by the trajectories, @b nullptr on a single search
  * @post this solution's fleet has the best solution found
  */
 Optimize::Optimize(
         const problem::Solution &old_solution,
         size_t max_cycles,
         bool stop_on_all_served,
-        bool optimize) :
+        bool optimize,
+        const Time_limit &time_limit,
+        size_t threads,
+        size_t trajectory,
+        Incumbent *incumbent) :
         problem::Solution(old_solution),
-        best_solution(old_solution),
+        m_trajectory(trajectory),
+        m_incumbent(incumbent),
+        m_threads(threads),
         m_max_cycles(max_cycles),
         m_stop_on_all_served(stop_on_all_served),
-        m_optimize(optimize) {
+        m_optimize(optimize),
+        m_time_limit(time_limit) {
     ENTERING(log);
+    /*
+     * the infeasible and seen lists of large problems keep a candidate per order and vehicle,
+     * up to TabuList::max_capacity
+     */
+    auto candidates = orders().size() * m_fleet.size();
+    tabu_list = TabuList(
+            std::max(TabuList::default_infeasible_capacity, candidates),
+            std::max(TabuList::default_seen_capacity, candidates));
+    save_best();
+    m_use_granular = orders().size() >= granular_min_orders;
+    m_use_intra_route = orders().size() >= intra_route_min_orders;
 
     /*
      * this function does the actual work
@@ -117,7 +190,7 @@ Optimize::Optimize(
     /*
      * Save best fleet/order structure found
      */
-    this->m_fleet = best_solution.fleet();
+    restore_best();
 
     log << tau("Best solution found");
     EXITING(log);
@@ -142,6 +215,12 @@ Optimize::move_2_real() {
 
     bool moves_were_done(false);
 
+    /*
+     * The travel time of the solution is kept up to date with the changes of the moved vehicles:
+     * it is not summed over the fleet for every candidate
+     */
+    auto travel_time = total_travel_time();
+
     /*
      * cycling to find phony vehicles
      */
@@ -157,6 +236,9 @@ Optimize::move_2_real() {
 
         auto orders_in_phony_vehicle = phony_vehicle.orders_in_vehicle();
         for (const auto o_id : orders_in_phony_vehicle) {
+            check_for_interrupts();
+            if (m_time_limit.reached()) break;
+
             /*
              * get the order to be inserted on a real vehicle
              */
@@ -208,7 +290,7 @@ Optimize::move_2_real() {
                 auto delta_travel_time = new_travel_time - curr_travel_time;
 
                 auto delta_objective = delta_travel_time;
-                auto estimated_objective = objective() + static_cast<double>(delta_objective);
+                auto estimated_objective = static_cast<double>(travel_time) + static_cast<double>(delta_objective);
 
 
                 if (best_score == 0 || estimated_objective < best_score) {
@@ -219,10 +301,13 @@ Optimize::move_2_real() {
 
             if (best_score != 0) {
                 pgassert(best_vehicle_ref != &phony_vehicle);
+                travel_time -= phony_vehicle.total_travel_time() + best_vehicle_ref->total_travel_time();
                 phony_vehicle.erase(order);
                 best_vehicle_ref->hillClimb(order);
+                travel_time += phony_vehicle.total_travel_time() + best_vehicle_ref->total_travel_time();
+                pgassert(travel_time == total_travel_time());
                 m_unassignedOrders -= order.idx();
-                best_solution = (*this);
+                save_best();
                 moves_were_done = true;
             }
         }  // orders
@@ -240,6 +325,8 @@ Optimize::move_2_real() {
 void
 Optimize::set_tabu_list_length() {
     auto max_length = std::max(orders().size(), m_standard_limit);
+    /* the trajectories of a multi-start search use longer lists: x1, x1.25, x1.5, x1.75 */
+    max_length += max_length * (m_trajectory % 4) / 4;
     tabu_list.set_max_length(max_length);
 }
 
@@ -252,6 +339,7 @@ Optimize::set_tabu_list_length() {
  * 1. all cycles are complete
  * 2. all possible orders are served without optimization and optimize is set to false
  * 3. all orders are served and stop_on_all_served is set to true
+ * 4. the time is over
  * The stopping condition stop_on_all_served exists in order to give a fast response to the user.
  * Note:
  * - Phony vehicles (if exist) have orders that have not been served
@@ -269,12 +357,14 @@ Optimize::set_tabu_list_length() {
  * Exit the loop when:
  * - all orders are served if stop_on_all_served
  * - maximum number of cycles is reached
+ * - the time is over
  */
 void
 Optimize::tabu_search() {
     ENTERING(log);
 
     sort_by_size(true);
+    if (m_trajectory > 0) shuffle_unassigned();
 
     m_unassignedOrders = set_unassignedOrders(m_fleet);
 
@@ -320,11 +410,19 @@ Optimize::tabu_search() {
     int wander_length = 100;
 
     while (iter < m_max_cycles) {
-        double curr_best = best_solution.objective();
+        check_for_interrupts();
+        if (m_time_limit.reached()) {
+            log << "\nTime limit reached on cycle " << iter;
+            break;
+        }
+
+        if (m_incumbent && iter > 0 && iter % exchange_cycles == 0) exchange();
+
+        double curr_best = m_best.objective;
 
         if (stuck_counter == max_no_improvement) {
             intensify();
-            if (best_solution.objective() == curr_best)
+            if (m_best.objective == curr_best)
                 break;
         }
 
@@ -367,7 +465,7 @@ Optimize::tabu_search() {
         /*
          * check for aimless wandering ...
          */
-        if (curr_best == best_solution.objective()) {
+        if (curr_best == m_best.objective) {
             stuck_counter += 1;
             if (stuck_counter % wander_length == 0) {
                 intensification = !intensification;
@@ -398,7 +496,7 @@ Optimize::tabu_search() {
  */
 void
 Optimize::intensify() {
-    m_fleet = best_solution.fleet();
+    restore_best();
 
     bool do_spi = true;
     bool do_sbr = true;
@@ -451,7 +549,12 @@ Optimize::diversify() {
 
 /** @brief Single Pair Insertion
  *
- * @returns false when a single pair insertion was not successful
+ * The candidates are evaluated in parallel on copies of the vehicles,
+ * then they are processed sequentially in the order of the loops
+ * (from vehicle, order, to vehicle), so the infeasible list and the chosen move
+ * are the same as evaluating them one at a time.
+ *
+ * @returns false when a single pair insertion was not successful or the time is over
  * @returns true when a single pair insertion was successful
  * @param [in] intensify to declare an intensification phase single pair insertion
  * @param [in] diversify to declare an diversification phase single pair insertion
@@ -459,6 +562,7 @@ Optimize::diversify() {
 bool
 Optimize::single_pair_insertion(bool intensify, bool diversify) {
     sort_by_size(true);
+    if (m_use_granular) m_granular.update(m_fleet, orders(), m_threads);
     auto best_to_v = &m_fleet[0];
     auto best_from_v = &m_fleet[0];
     double best_score = intensify ? objective() : 0;
@@ -468,16 +572,18 @@ Optimize::single_pair_insertion(bool intensify, bool diversify) {
     auto best_order = orders()[0];
     bool has_phony = false;
 
-    std::string best_candidate;
+    uint64_t best_candidate = 0;
 
-    for (auto &from_vehicle : m_fleet) {
+    std::vector<Insertion_candidate> candidates;
+    for (size_t i = 0; i < m_fleet.size(); ++i) {
+        auto &from_vehicle = m_fleet[i];
         if (from_vehicle.is_phony() || from_vehicle.empty()) continue;
 
         auto first_order_set = from_vehicle.orders_in_vehicle();
         for (const auto o_id : first_order_set) {
-            auto order = orders()[o_id];
-            for (auto &to_v : m_fleet) {
-                if (&from_vehicle == &to_v) continue;
+            for (size_t j = 0; j < m_fleet.size(); ++j) {
+                auto &to_v = m_fleet[j];
+                if (i == j) continue;
                 if (to_v.is_phony()) {
                     has_phony = true;
                 }
@@ -485,81 +591,81 @@ Optimize::single_pair_insertion(bool intensify, bool diversify) {
                 if (!has_phony && to_v.empty()) continue;
 
                 if (!to_v.feasible_orders().has(o_id)) continue;
+                if (!is_near(to_v, o_id)) continue;
 
-                std::ostringstream ss;
-
-                ss << to_v.path_str() << ":" << o_id;
-
-                std::string candidate = ss.str();
-
-                if (tabu_list.has_infeasible(candidate)) continue;
+                auto candidate = TabuList::candidate(to_v, o_id);
 
+                /* the seen list does not change while looking for the move */
                 if (diversify && tabu_list.has_seen(candidate)) continue;
 
-                /*
-                 * setup local working vehicles
-                 */
-                auto to_v_copy = to_v;
-                auto from_v_copy = from_vehicle;
-
-                /* current travel_time */
-                auto curr_travel_time = from_v_copy.total_travel_time() + to_v_copy.total_travel_time();
+                candidates.push_back({i, j, o_id, candidate, false, {}, {}, false, false});
+            }  // to vehicles
+        }  // orders
+    }  // from vehicles
 
-                /*
-                 * insert order on destination vehicle
-                 */
-                pgassert(!to_v_copy.has_order(order));
-                to_v_copy.hillClimb(order);
+    evaluate_in_parallel(candidates, diversify);
+    check_for_interrupts();
+    if (m_time_limit.reached()) return false;
 
-                // either the to vehicle has the order and is feasible OR it does not have the order
-                pgassert((to_v_copy.has_order(order) && to_v_copy.is_feasible()) || !to_v_copy.has_order(order));
+    auto curr_objective = objective();
+    for (auto &c : candidates) {
+        if (tabu_list.has_infeasible(c.candidate)) continue;
 
-                /*
-                 * Skip to next order if the order wasn't inserted
-                 */
-                if (!to_v_copy.has_order(order)) {
-                    tabu_list.add_infeasible(candidate);
-                    continue;
-                }
+        /* was infeasible when the evaluation started */
+        if (!c.evaluated) {
+            evaluate(c, diversify, false);
+            remember(c);
+        }
 
-                from_v_copy.erase(order);
-                if (from_v_copy.has_order(order) || !from_v_copy.is_feasible()) continue;
+        /*
+         * Skip to next order if the order wasn't inserted
+         */
+        if (!c.insertion.inserted) {
+            tabu_list.add_infeasible(c.candidate);
+            continue;
+        }
 
-                auto new_travel_time = from_v_copy.total_travel_time() + to_v_copy.total_travel_time();
-                auto delta_travel_time = new_travel_time - curr_travel_time;
+        if (!c.removal.feasible) continue;
 
-                auto delta_objective = delta_travel_time;
-                auto estimated_objective = objective() + static_cast<double>(delta_objective);
+        auto &from_vehicle = m_fleet[c.from];
+        auto &to_v = m_fleet[c.to];
+        auto order = orders()[c.o_id];
 
-                /*
-                 * evaluate the move
-                 */
-                if (estimated_objective >= best_score && !from_v_copy.empty() && best_score != 0) continue;
+        /* current travel_time */
+        auto curr_travel_time = from_vehicle.total_travel_time() + to_v.total_travel_time();
+        auto new_travel_time = c.removal.travel_time + c.insertion.travel_time;
+        auto delta_travel_time = new_travel_time - curr_travel_time;
 
-                if (tabu_list.has_move(
-                            from_v_copy, to_v_copy, order, to_v_copy.objective(),
-                            from_v_copy.objective())
-                        && estimated_objective >= best_solution.objective()
-                        && !from_v_copy.empty()) continue;
+        auto estimated_objective = curr_objective + static_cast<double>(delta_travel_time);
 
-                if (estimated_objective < best_score || from_v_copy.empty() || best_score == 0) {
-                    moved = true;
-                    best_score = estimated_objective;
-                    best_to_score = to_v.objective();
-                    best_from_score = from_vehicle.objective();
-                    best_to_v = &to_v;
-                    best_from_v = &from_vehicle;
-                    best_order = order;
-                    best_candidate = candidate;
-                }
-            }  // to vehicles
-        }  // orders
-    }  // from vehicles
+        /*
+         * evaluate the move
+         */
+        if (estimated_objective >= best_score && !c.removal.empty && best_score != 0) continue;
+
+        if (tabu_list.has_move(
+                    from_vehicle, to_v, order, to_v.objective(),
+                    from_vehicle.objective())
+                && estimated_objective >= m_best.objective
+                && !c.removal.empty) continue;
+
+        if (estimated_objective < best_score || c.removal.empty || best_score == 0) {
+            moved = true;
+            best_score = estimated_objective;
+            best_to_score = to_v.objective();
+            best_from_score = from_vehicle.objective();
+            best_to_v = &to_v;
+            best_from_v = &from_vehicle;
+            best_order = order;
+            best_candidate = c.candidate;
+        }
+    }
 
     if (moved) {
         tabu_list.add(Move((*best_from_v), (*best_to_v), best_order, best_to_score, best_from_score));
         best_to_v->hillClimb(best_order);
         best_from_v->erase(best_order);
+        improve_routes(*best_from_v, *best_to_v);
         tabu_list.add_seen(best_candidate);
         if (best_from_v->is_phony()) m_unassignedOrders -= best_order.idx();
         save_if_best();
@@ -570,7 +676,12 @@ Optimize::single_pair_insertion(bool intensify, bool diversify) {
 
 /** @brief Swap Between Routes
  *
- * @returns false when a swap between routes was not successful
+ * The candidates are evaluated in parallel on copies of the vehicles,
+ * then they are processed sequentially in the order of the loops
+ * (from vehicle, from order, to vehicle, to order), so the infeasible list and the chosen swap
+ * are the same as evaluating them one at a time.
+ *
+ * @returns false when a swap between routes was not successful or the time is over
  * @returns true when a swap between routes was successful
  * @param [in] intensify to declare an intensification phase swap between routes
  * @param [in] diversify to declare an diversification phase swap between routes
@@ -578,6 +689,7 @@ Optimize::single_pair_insertion(bool intensify, bool diversify) {
 bool
 Optimize::swap_between_routes(bool intensify, bool diversify) {
     sort_by_size(false);
+    if (m_use_granular) m_granular.update(m_fleet, orders(), m_threads);
     auto best_to_v = &m_fleet[0];
     auto best_from_v = &m_fleet[0];
     double best_score = intensify ? objective() : 0;
@@ -587,122 +699,105 @@ Optimize::swap_between_routes(bool intensify, bool diversify) {
     auto best_from_order = orders()[0];
     auto best_to_order = orders()[0];
 
-    std::string best_candidate1;
-    std::string best_candidate2;
+    uint64_t best_candidate1 = 0;
+    uint64_t best_candidate2 = 0;
 
+    std::vector<Swap_candidate> candidates;
     for (size_t i = 0; i < m_fleet.size(); ++i)  {
         problem::Vehicle_pickDeliver &from_vehicle = m_fleet[i];
         if (from_vehicle.is_phony() || from_vehicle.empty()) continue;
 
         auto first_order_set = from_vehicle.orders_in_vehicle();
         for (const auto o_id1 : first_order_set) {
-            auto order1 = orders()[o_id1];
             for (size_t j = i + 1; j < m_fleet.size(); ++j) {
                 problem::Vehicle_pickDeliver &to_v = m_fleet[j];
-                if (&from_vehicle == &to_v) continue;
                 if (to_v.is_phony() || to_v.empty()) continue;
                 if (!to_v.feasible_orders().has(o_id1)) continue;
-
+                if (!is_near(to_v, o_id1)) continue;
 
                 /*
                  * cycle through to orders for swap
                  */
                 auto second_order_set = to_v.orders_in_vehicle();
                 for (const auto o_id2 : second_order_set) {
-                    auto order2 = orders()[o_id2];
                     if (!from_vehicle.feasible_orders().has(o_id2)) continue;
+                    if (!is_near(from_vehicle, o_id2)) continue;
+                    candidates.push_back({i, j, o_id1, o_id2, 0, 0, {}, {}, false, {}, {}, false, false, false, false});
+                }
+            }  // to vehicles
+        }  // orders
+    }  // from vehicles
 
-                    auto curr_from_objective = from_vehicle.objective();
-                    auto curr_to_objective = to_v.objective();
-
-                    /*
-                     * setup local working vehicles
-                     */
-                    auto from_v_copy = from_vehicle;
-                    auto to_v_copy = to_v;
-
-
-                    pgassert(from_v_copy.has_order(order1));
-                    pgassert(to_v_copy.has_order(order2));
-
-
-                    /*
-                     * do one truck at a time
-                     */
-                    to_v_copy.erase(order2);
-                    if (to_v_copy.orders_in_vehicle().has(o_id2) || !to_v_copy.is_feasible()) continue;
-
-                    std::ostringstream ss1;
-                    ss1 << to_v_copy.path_str() << ":" << o_id1;
-
-                    std::string candidate1 = ss1.str();
-
-                    if (tabu_list.has_infeasible(candidate1)) continue;
-
-                    from_v_copy.erase(order1);
-                    if (from_v_copy.orders_in_vehicle().has(o_id1) || !from_v_copy.is_feasible()) continue;
-
-                    std::ostringstream ss2;
-                    ss2 << from_v_copy.path_str() << ":" << o_id2;
-
-                    std::string candidate2 = ss2.str();
-
-                    if (diversify && tabu_list.has_seen(candidate1) && tabu_list.has_seen(candidate2)) continue;
-
-                    if (tabu_list.has_infeasible(candidate2)) continue;
+    evaluate_in_parallel(candidates, diversify);
+    check_for_interrupts();
+    if (m_time_limit.reached()) return false;
 
-                    to_v_copy.hillClimb(order1);
-                    if (!to_v_copy.has_order(order1) || !to_v_copy.is_feasible()) {
-                        tabu_list.add_infeasible(candidate1);
-                        continue;
-                    }
+    auto curr_objective = objective();
+    for (auto &c : candidates) {
+        if (!c.to_removal.feasible) continue;
+        if (tabu_list.has_infeasible(c.candidate1)) continue;
 
+        if (!c.from_removal.feasible) continue;
+        if (diversify && tabu_list.has_seen(c.candidate1) && tabu_list.has_seen(c.candidate2)) continue;
+        if (tabu_list.has_infeasible(c.candidate2)) continue;
 
-                    from_v_copy.hillClimb(order2);
-                    if (!from_v_copy.has_order(order2) || !from_v_copy.is_feasible()) {
-                        tabu_list.add_infeasible(candidate2);
-                        continue;
-                    }
+        /* was infeasible when the evaluation started */
+        if (!c.evaluated) {
+            evaluate(c, diversify, false);
+            remember(c);
+        }
 
+        if (!c.to_insertion.inserted || !c.to_insertion.feasible) {
+            tabu_list.add_infeasible(c.candidate1);
+            continue;
+        }
 
-                    /*
-                     * Evaluate the swap
-                     */
-                    auto new_from_objective = from_v_copy.objective();
-                    auto new_to_objective = to_v_copy.objective();
+        if (!c.from_insertion.inserted || !c.from_insertion.feasible) {
+            tabu_list.add_infeasible(c.candidate2);
+            continue;
+        }
 
-                    auto estimated_delta =
-                            +(new_to_objective + new_from_objective)
-                            - (curr_from_objective + curr_to_objective);
+        problem::Vehicle_pickDeliver &from_vehicle = m_fleet[c.from];
+        problem::Vehicle_pickDeliver &to_v = m_fleet[c.to];
+        auto order1 = orders()[c.o_id1];
+        auto order2 = orders()[c.o_id2];
 
-                    auto estimated_objective = objective() + estimated_delta;
-                    /*
-                     * dont swap if there is no improvement in either vehicle
-                     */
-                    if (estimated_objective >= best_score && best_score != 0) continue;
+        /*
+         * Evaluate the swap
+         */
+        auto curr_from_objective = from_vehicle.objective();
+        auto curr_to_objective = to_v.objective();
 
-                    if (tabu_list.has_swap(
-                                from_v_copy, to_v_copy, order1, order2, from_v_copy.objective(),
-                                to_v_copy.objective())
-                        && estimated_objective >= best_solution.objective()) continue;
+        auto estimated_delta =
+                +(c.to_insertion.objective + c.from_insertion.objective)
+                - (curr_from_objective + curr_to_objective);
 
+        auto estimated_objective = curr_objective + estimated_delta;
+        /*
+         * dont swap if there is no improvement in either vehicle
+         */
+        if (estimated_objective >= best_score && best_score != 0) continue;
+
+        if (tabu_list.has_swap(
+                    from_vehicle, to_v, order1, order2, c.from_insertion.objective,
+                    c.to_insertion.objective)
+            && estimated_objective >= m_best.objective) continue;
+
+
+        if (estimated_objective < best_score || best_score == 0) {
+            swapped = true;
+            best_from_score = from_vehicle.objective();
+            best_to_score = to_v.objective();
+            best_score = estimated_objective;
+            best_to_v = &to_v;
+            best_from_v = &from_vehicle;
+            best_from_order = order1;
+            best_to_order = order2;
+            best_candidate1 = c.candidate1;
+            best_candidate2 = c.candidate2;
+        }
+    }
 
-                    if (estimated_objective < best_score || best_score == 0) {
-                        swapped = true;
-                        best_from_score = from_vehicle.objective();
-                        best_to_score = to_v.objective();
-                        best_score = estimated_objective;
-                        best_to_v = &to_v;
-                        best_from_v = &from_vehicle;
-                        best_from_order = order1;
-                        best_to_order = order2;
-                        best_candidate1 = candidate1;
-                        best_candidate2 = candidate2;
-                    }
-                }
-            }  // to vehicles
-        }  // orders
-    }  // from vehicles
     if (swapped) {
         tabu_list.add(
                 Move((*best_from_v), (*best_to_v), best_from_order, best_to_order, best_to_score, best_from_score));
@@ -710,6 +805,7 @@ Optimize::swap_between_routes(bool intensify, bool diversify) {
         best_to_v->erase(best_to_order);
         best_from_v->hillClimb(best_to_order);
         best_to_v->hillClimb(best_from_order);
+        improve_routes(*best_from_v, *best_to_v);
         tabu_list.add_seen(best_candidate1);
         tabu_list.add_seen(best_candidate2);
         if (best_from_v->is_phony()) {
@@ -725,47 +821,217 @@ Optimize::swap_between_routes(bool intensify, bool diversify) {
     return swapped;
 }
 
+
+/**
+ * The evaluations only read the solution, the lists and the memo, each candidate keeps its own results.
+ * The new results are kept on the memo after all the evaluations finish.
+ *
+ * Candidates that are on the infeasible list when the evaluation starts are not evaluated:
+ * the list can forget them later, then they are evaluated when they are processed.
+ *
+ * When the time is over the remaining candidates are not evaluated.
+ *
+ * @param [in,out] candidates of the neighbourhood, in the order they are processed
+ * @param [in] diversify the diversification phase skips the seen candidates
+ */
+template <typename Candidate>
+void
+Optimize::evaluate_in_parallel(std::vector<Candidate> &candidates, bool diversify) {
+    refresh_route_memo();
+    parallel_for(0, candidates.size(), candidates_per_thread, [&](size_t first, size_t last) {
+        for (auto k = first; k < last && !m_time_limit.reached(); ++k) evaluate(candidates[k], diversify, true);
+    }, m_threads);
+    for (const auto &c : candidates) remember(c);
+}
+
+
+/**
+ * A route that changed has a different key: its results are forgotten
+ *
+ * The memo is keyed by the vehicle and its route, so the results are only used on the same vehicle with the same route
+ */
+void
+Optimize::refresh_route_memo() {
+    std::unordered_map<uint64_t, Route_memo> route_memo;
+    for (const auto &vehicle : m_fleet) {
+        if (vehicle.is_phony()) continue;
+        auto key = memo_key(vehicle);
+        if (route_memo.count(key)) continue;
+        auto memo = m_route_memo.find(key);
+        route_memo[key] = memo == m_route_memo.end() ? Route_memo() : std::move(memo->second);
+    }
+    m_route_memo = std::move(route_memo);
+}
+
+
+/**
+ * @param [in,out] c the candidate
+ * @param [in] skip_infeasible do not evaluate the candidate when it is on the infeasible list
+ *
+ * The seen list was checked when the candidate was created
+ */
+void
+Optimize::evaluate(Insertion_candidate &c, bool, bool skip_infeasible) const {
+    if (skip_infeasible && tabu_list.has_infeasible(c.candidate)) return;
+
+    auto order = orders()[c.o_id];
+    const auto &to_v = m_fleet[c.to];
+    const auto &from_vehicle = m_fleet[c.from];
+    c.evaluated = true;
+
+    /*
+     * insert order on destination vehicle
+     */
+    c.new_insertion = !find_result(m_route_memo.at(memo_key(to_v)).insertion, c.o_id, c.insertion);
+    if (c.new_insertion) c.insertion = insert_order(to_v, order);
+
+    // either the to vehicle has the order and is feasible OR it does not have the order
+    pgassert((c.insertion.inserted && c.insertion.feasible) || !c.insertion.inserted);
+
+    if (!c.insertion.inserted) return;
+
+    c.new_removal = !find_result(m_route_memo.at(memo_key(from_vehicle)).removal, c.o_id, c.removal);
+    if (c.new_removal) c.removal = erase_order(from_vehicle, order);
+}
+
+
+/**
+ * @param [in,out] c the candidate
+ * @param [in] diversify the diversification phase skips the seen candidates
+ * @param [in] skip_infeasible do not do the hill climbs when a candidate is on the infeasible list
+ */
+void
+Optimize::evaluate(Swap_candidate &c, bool diversify, bool skip_infeasible) const {
+    auto order1 = orders()[c.o_id1];
+    auto order2 = orders()[c.o_id2];
+    const auto &from_vehicle = m_fleet[c.from];
+    const auto &to_v = m_fleet[c.to];
+    const auto &from_memo = m_route_memo.at(memo_key(from_vehicle));
+    const auto &to_memo = m_route_memo.at(memo_key(to_v));
+
+    pgassert(from_vehicle.has_order(order1));
+    pgassert(to_v.has_order(order2));
+
+    /*
+     * do one truck at a time
+     */
+    c.new_to_removal = !find_result(to_memo.removal, c.o_id2, c.to_removal);
+    if (c.new_to_removal) c.to_removal = erase_order(to_v, order2);
+    if (!c.to_removal.feasible) return;
+    c.candidate1 = TabuList::candidate(c.to_removal.path_hash, c.o_id1);
+
+    c.new_from_removal = !find_result(from_memo.removal, c.o_id1, c.from_removal);
+    if (c.new_from_removal) c.from_removal = erase_order(from_vehicle, order1);
+    if (!c.from_removal.feasible) return;
+    c.candidate2 = TabuList::candidate(c.from_removal.path_hash, c.o_id2);
+
+    if (diversify && tabu_list.has_seen(c.candidate1) && tabu_list.has_seen(c.candidate2)) return;
+    if (skip_infeasible
+            && (tabu_list.has_infeasible(c.candidate1) || tabu_list.has_infeasible(c.candidate2))) return;
+
+    c.evaluated = true;
+    c.new_to_insertion = !find_result(to_memo.exchange, exchange_key(c.o_id2, c.o_id1), c.to_insertion);
+    if (c.new_to_insertion) c.to_insertion = exchange_orders(to_v, order2, order1);
+    if (!c.to_insertion.inserted || !c.to_insertion.feasible) return;
+
+    c.new_from_insertion = !find_result(from_memo.exchange, exchange_key(c.o_id1, c.o_id2), c.from_insertion);
+    if (c.new_from_insertion) c.from_insertion = exchange_orders(from_vehicle, order1, order2);
+}
+
+
+void
+Optimize::remember(const Insertion_candidate &c) {
+    if (c.new_insertion) m_route_memo[memo_key(m_fleet[c.to])].insertion.emplace(c.o_id, c.insertion);
+    if (c.new_removal) m_route_memo[memo_key(m_fleet[c.from])].removal.emplace(c.o_id, c.removal);
+}
+
+
+void
+Optimize::remember(const Swap_candidate &c) {
+    auto &from_memo = m_route_memo[memo_key(m_fleet[c.from])];
+    auto &to_memo = m_route_memo[memo_key(m_fleet[c.to])];
+    if (c.new_to_removal) to_memo.removal.emplace(c.o_id2, c.to_removal);
+    if (c.new_from_removal) from_memo.removal.emplace(c.o_id1, c.from_removal);
+    if (c.new_to_insertion) to_memo.exchange.emplace(exchange_key(c.o_id2, c.o_id1), c.to_insertion);
+    if (c.new_from_insertion) from_memo.exchange.emplace(exchange_key(c.o_id1, c.o_id2), c.from_insertion);
+}
+
+
+Optimize::Insertion_result
+Optimize::insert_order(const problem::Vehicle_pickDeliver &vehicle, const problem::Order &order) {
+    auto vehicle_copy = vehicle;
+    pgassert(!vehicle_copy.has_order(order));
+    vehicle_copy.hillClimb(order);
+    return {vehicle_copy.has_order(order), vehicle_copy.is_feasible(),
+        vehicle_copy.total_travel_time(), vehicle_copy.objective()};
+}
+
+
+Optimize::Removal_result
+Optimize::erase_order(const problem::Vehicle_pickDeliver &vehicle, const problem::Order &order) {
+    auto vehicle_copy = vehicle;
+    vehicle_copy.erase(order);
+    return {!vehicle_copy.has_order(order) && vehicle_copy.is_feasible(), vehicle_copy.empty(),
+        vehicle_copy.total_travel_time(), vehicle_copy.path_hash()};
+}
+
+
+Optimize::Insertion_result
+Optimize::exchange_orders(
+        const problem::Vehicle_pickDeliver &vehicle,
+        const problem::Order &removed,
+        const problem::Order &inserted) {
+    auto vehicle_copy = vehicle;
+    vehicle_copy.erase(removed);
+    vehicle_copy.hillClimb(inserted);
+    return {vehicle_copy.has_order(inserted), vehicle_copy.is_feasible(),
+        vehicle_copy.total_travel_time(), vehicle_copy.objective()};
+}
+
 #if 1
 /**
+ * The positions of the vehicles are sorted, the vehicles are moved once at the end
  *
  * @post pv1.size <= pv2.size  ... <=  pvN.size  v1.size <= v2.size  ... <=  vN.size
  */
 void
 Optimize::sort_by_size(bool asc) {
+    std::vector<size_t> positions(m_fleet.size());
+    std::iota(positions.begin(), positions.end(), 0);
+
     /*
      * sort by number of orders on the vehicles
      */
     if (asc) {
-        std::sort(m_fleet.begin(), m_fleet.end(), []
-                (const problem::Vehicle_pickDeliver &lhs, const problem::Vehicle_pickDeliver &rhs)
-                -> bool {
-            if (lhs.orders_in_vehicle().size() == rhs.orders_in_vehicle().size()) {
-                return lhs.id() < rhs.id();
+        std::sort(positions.begin(), positions.end(), [&](size_t lhs, size_t rhs) -> bool {
+            auto lhs_size = m_fleet[lhs].orders_size();
+            auto rhs_size = m_fleet[rhs].orders_size();
+            if (lhs_size == rhs_size) {
+                return m_fleet[lhs].id() < m_fleet[rhs].id();
             } else {
-                return lhs.orders_in_vehicle().size() < rhs.orders_in_vehicle().size();
+                return lhs_size < rhs_size;
             }
         });
     } else {
-        std::sort(m_fleet.begin(), m_fleet.end(), []
-                (const problem::Vehicle_pickDeliver &lhs, const problem::Vehicle_pickDeliver &rhs)
-                -> bool {
-            if (lhs.orders_in_vehicle().size() == rhs.orders_in_vehicle().size()) {
-                return lhs.id() > rhs.id();
+        std::sort(positions.begin(), positions.end(), [&](size_t lhs, size_t rhs) -> bool {
+            auto lhs_size = m_fleet[lhs].orders_size();
+            auto rhs_size = m_fleet[rhs].orders_size();
+            if (lhs_size == rhs_size) {
+                return m_fleet[lhs].id() > m_fleet[rhs].id();
             } else {
-                return lhs.orders_in_vehicle().size() > rhs.orders_in_vehicle().size();
+                return lhs_size > rhs_size;
             }
         });
     }
 
-
     /*
      * Leave the phony vehicles at the beginning
      */
-    std::stable_partition(m_fleet.begin(), m_fleet.end(), []
-            (const problem::Vehicle_pickDeliver &v)
-            -> bool {
-            return v.id() < 0;
+    std::stable_partition(positions.begin(), positions.end(), [&](size_t p) -> bool {
+            return m_fleet[p].id() < 0;
             });
+
+    arrange_fleet(positions);
 }
 #endif
 
@@ -795,10 +1061,127 @@ Optimize::delete_empty_truck() {
  */
 void
 Optimize::save_if_best() {
-    if (objective() < best_solution.objective()) {
-        best_solution = (*this);
-        log << "\t***  best objective " << best_solution.cost_str();
+    if (objective() < m_best.objective) {
+        save_best();
+        log << "\t***  best objective " << cost_str();
+    }
+}
+
+
+/**
+ * Local search inside the routes changed by a move
+ *
+ * @param [in,out] from_vehicle, to_vehicle the vehicles changed by the move
+ */
+void
+Optimize::improve_routes(problem::Vehicle_pickDeliver &from_vehicle, problem::Vehicle_pickDeliver &to_vehicle) {
+    if (!m_use_intra_route) return;
+    from_vehicle.improve_route();
+    to_vehicle.improve_route();
+}
+
+
+void
+Optimize::save_best() {
+    m_best = snapshot();
+}
+
+
+void
+Optimize::restore_best() {
+    restore(m_best);
+}
+
+
+Optimize::Best_solution
+Optimize::snapshot() const {
+    Best_solution solution;
+    solution.vehicle_ids.reserve(m_fleet.size());
+    solution.routes.reserve(m_fleet.size());
+    solution.unassigned = 0;
+    for (const auto &vehicle : m_fleet) {
+        solution.vehicle_ids.push_back(vehicle.id());
+        solution.routes.push_back(vehicle.route());
+        if (vehicle.is_phony()) solution.unassigned += vehicle.orders_size();
+    }
+    solution.objective = objective();
+    return solution;
+}
+
+
+/**
+ * The vehicles of the solution are taken from the current fleet
+ * - the phony vehicles all have the same data: the ones that were deleted are copies of the fleet's phony vehicle
+ */
+void
+Optimize::restore(const Best_solution &solution) {
+    std::unordered_map<int64_t, std::vector<size_t>> positions;
+    for (size_t i = m_fleet.size(); i-- > 0; ) positions[m_fleet[i].id()].push_back(i);
+
+    std::deque<problem::Vehicle_pickDeliver> fleet;
+    for (size_t i = 0; i < solution.routes.size(); ++i) {
+        auto &available = positions[solution.vehicle_ids[i]];
+        if (available.empty()) {
+            pgassert(solution.vehicle_ids[i] < 0);
+            fleet.push_back(vehicles().get_phony());
+        } else {
+            fleet.push_back(std::move(m_fleet[available.back()]));
+            available.pop_back();
+        }
+        fleet.back().set_route(solution.routes[i]);
+    }
+    m_fleet = std::move(fleet);
+}
+
+
+/**
+ * The trajectory gives the key of its best solution, the incumbent decides:
+ * - the best trajectory of the meeting gives its best solution when it is better than the incumbent
+ * - the worst trajectory of the meeting restarts from the incumbent when it is far from it
+ */
+void
+Optimize::exchange() {
+    auto adopted = m_incumbent->exchange(
+            {m_best.unassigned, m_best.objective, m_trajectory},
+            [this]() {
+                auto current = snapshot();
+                restore_best();
+                problem::Solution best(*this);
+                restore(current);
+                return best;
+            });
+    if (!adopted) return;
+
+    m_fleet = adopted->fleet();
+    m_unassignedOrders = set_unassignedOrders(m_fleet);
+    tabu_list.clear();
+    save_best();
+    log << "\n\ttrajectory " << m_trajectory << " restarts from the incumbent " << cost_str();
+}
+
+
+/**
+ * The phony vehicles exchange their positions on the fleet:
+ * move_2_real takes the unassigned orders in the order of the fleet
+ */
+void
+Optimize::shuffle_unassigned() {
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < m_fleet.size(); ++i) {
+        if (m_fleet[i].is_phony()) positions.push_back(i);
     }
+
+    std::mt19937 generator(static_cast<uint32_t>(m_trajectory));
+    for (size_t i = positions.size(); i > 1; --i) {
+        auto j = static_cast<size_t>(generator() % i);
+        std::swap(m_fleet[positions[i - 1]], m_fleet[positions[j]]);
+    }
+}
+
+
+void
+Optimize::check_for_interrupts() const {
+    if (!m_incumbent) CHECK_FOR_INTERRUPTS();
 }
 
 }  //  namespace tabu
@@ -28,10 +28,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "optimizers/tabu_list.hpp"
 
-#include <string>
+#include <cstdint>
 #include <iostream>
 #include <algorithm>
 
+#include "problem/vehicle_pickDeliver.hpp"
+#include "problem/order.hpp"
+
 namespace vrprouting {
 namespace optimizers {
 namespace tabu {
@@ -40,8 +43,11 @@ namespace tabu {
  * @param [in] m the move
  */
 void TabuList::add(const Move &m) {
-    if (has(m))  return;
-    while (size() >= max_length()) m_tabu_list.pop_front();
+    if (!m_tabu_keys.insert(key(m)).second) return;
+    while (size() >= max_length() && !m_tabu_list.empty()) {
+        m_tabu_keys.erase(key(m_tabu_list.front()));
+        m_tabu_list.pop_front();
+    }
     m_tabu_list.push_back(m);
 }
 
@@ -49,15 +55,16 @@ void TabuList::add(const Move &m) {
  */
 void TabuList::clear() {
     m_tabu_list.clear();
+    m_tabu_keys.clear();
 }
 
 /**
- * @param [in] m move searched for
+ * @param [in] k key of the move searched for
  * @returns true when the move was found in the tabu list
  * @returns false when the move was not found in the tabu list
  */
-bool TabuList::has(const Move &m) const {
-    return std::find(m_tabu_list.begin(), m_tabu_list.end(), m) != m_tabu_list.end();
+bool TabuList::has(const Key &k) const {
+    return m_tabu_keys.find(k) != m_tabu_keys.end();
 }
 
 /**
@@ -73,8 +80,10 @@ bool TabuList::has(const Move &m) const {
 bool TabuList::has_move(const problem::Vehicle_pickDeliver& from_vehicle,
                         const problem::Vehicle_pickDeliver& to_vehicle,
                         const problem::Order& order, double obj1, double obj2) const {
-    return has({from_vehicle, to_vehicle, order, obj1, obj2}) ||
-            has({to_vehicle, from_vehicle, order, obj1, obj2});
+    (void) obj1;
+    (void) obj2;
+    return has({from_vehicle.id(), to_vehicle.id(), order.id(), 0, false}) ||
+            has({to_vehicle.id(), from_vehicle.id(), order.id(), 0, false});
 }
 
 /**
@@ -92,10 +101,12 @@ bool TabuList::has_swap(const problem::Vehicle_pickDeliver& from_vehicle,
                         const problem::Vehicle_pickDeliver& to_vehicle,
                         const problem::Order& from_order,
                         const problem::Order& to_order, double obj1, double obj2) const {
-    return has({from_vehicle, to_vehicle, from_order, to_order, obj1, obj2}) ||
-            has({from_vehicle, to_vehicle, to_order, from_order, obj1, obj2}) ||
-            has({to_vehicle, from_vehicle, from_order, to_order, obj1, obj2}) ||
-            has({to_vehicle, from_vehicle, to_order, from_order, obj1, obj2});
+    (void) obj1;
+    (void) obj2;
+    return has({from_vehicle.id(), to_vehicle.id(), from_order.id(), to_order.id(), true}) ||
+            has({from_vehicle.id(), to_vehicle.id(), to_order.id(), from_order.id(), true}) ||
+            has({to_vehicle.id(), from_vehicle.id(), from_order.id(), to_order.id(), true}) ||
+            has({to_vehicle.id(), from_vehicle.id(), to_order.id(), from_order.id(), true});
 }
 
 
@@ -147,23 +158,32 @@ operator << (std::ostream &log, const TabuList &list) {
     return log;
 }
 
-bool TabuList::has_infeasible(const std::string& candidate) {
-    return (m_infeasible_list.find(candidate) != m_infeasible_list.end());
+/**
+ * @param [in] vehicle where the order is inserted
+ * @param [in] order_idx index of the order
+ *
+ * @returns the fingerprint of the vehicle's path and the order
+ */
+uint64_t TabuList::candidate(const problem::Vehicle_pickDeliver &vehicle, size_t order_idx) {
+    return candidate(vehicle.path_hash(), order_idx);
 }
 
-void TabuList::add_infeasible(const std::string& candidate) {
+bool TabuList::has_infeasible(uint64_t candidate) const {
+    return m_infeasible_list.has(candidate);
+}
+
+void TabuList::add_infeasible(uint64_t candidate) {
     m_infeasible_list.insert(candidate);
 }
 
-bool TabuList::has_seen(const std::string& candidate) {
-    return (m_seen_list.find(candidate) != m_seen_list.end());
+bool TabuList::has_seen(uint64_t candidate) const {
+    return m_seen_list.has(candidate);
 }
 
-void TabuList::add_seen(const std::string& candidate) {
+void TabuList::add_seen(uint64_t candidate) {
     m_seen_list.insert(candidate);
 }
 
-
 }  //  namespace tabu
 }  //  namespace optimizers
 }  //  namespace vrprouting
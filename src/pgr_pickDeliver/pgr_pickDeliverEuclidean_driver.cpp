@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "drivers/pgr_pickDeliverEuclidean_driver.h"
 
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -37,6 +38,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "cpp_common/alloc.hpp"
 #include "cpp_common/assert.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "cpp_common/time_limit.hpp"
 #include "cpp_common/pgdata_getters.hpp"
 #include "cpp_common/orders_t.hpp"
 #include "cpp_common/vehicle_t.hpp"
@@ -55,13 +58,19 @@ get_initial_solution(vrprouting::problem::PickDeliver &problem_ptr, int m_initia
     using Initials_code = vrprouting::initialsol::simple::Initials_code;
     Solution m_solutions(problem_ptr);
     if (m_initial_id == 0) {
-        for (int i = 1; i < 7; ++i) {
-            if (i == 1) {
-                m_solutions = Initial_solution((Initials_code)i, problem_ptr);
-            } else {
-                auto new_sol = Initial_solution((Initials_code)i, problem_ptr);
-                m_solutions = (new_sol < m_solutions)? new_sol : m_solutions;
+        /*
+         * The initial solutions only read the problem: they are built using several threads
+         */
+        std::vector<std::unique_ptr<Solution>> candidates(6);
+        vrprouting::parallel_for(0, candidates.size(), 1, [&](size_t first, size_t last) {
+            for (auto i = first; i < last; ++i) {
+                candidates[i] = std::make_unique<Solution>(
+                        Initial_solution(static_cast<Initials_code>(i + 1), problem_ptr));
             }
+        });
+        m_solutions = *candidates[0];
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            m_solutions = (*candidates[i] < m_solutions)? *candidates[i] : m_solutions;
         }
     } else {
         m_solutions = Initial_solution((Initials_code)m_initial_id, problem_ptr);
@@ -80,6 +89,7 @@ vrp_do_pgr_pickDeliverEuclidean(
         double factor,
         int max_cycles,
         int initial_solution_id,
+        int timeout,
 
         Solution_rt **return_tuples,
         size_t *return_count,
@@ -112,9 +122,15 @@ vrp_do_pgr_pickDeliverEuclidean(
         pgassert(*return_count == 0);
         pgassert(!(*return_tuples));
 
-        if (initial_solution_id < 0 || initial_solution_id > 7) {
+        if (timeout < -1) {
+            *err_msg = to_pg_msg("Illegal value in parameter: timeout");
+            *log_msg = to_pg_msg("Expected value: timeout >= -1 (-1: no time limit)");
+            return;
+        }
+
+        if (initial_solution_id < 0 || initial_solution_id > 8) {
             *err_msg = to_pg_msg("Illegal value in parameter: initial_sol");
-            *log_msg = to_pg_msg("Expected value: 0 <= initial_sol <= 7");
+            *log_msg = to_pg_msg("Expected value: 0 <= initial_sol <= 8");
             return;
         }
 
@@ -130,6 +146,11 @@ vrp_do_pgr_pickDeliverEuclidean(
             return;
         }
 
+        /*
+         * the time given starts now
+         */
+        vrprouting::Time_limit time_limit(timeout);
+
         /*
 	 * Data input starts
          */
@@ -221,7 +242,7 @@ vrp_do_pgr_pickDeliverEuclidean(
         /*
          * Solve (optimize)
          */
-        sol = Optimize(sol, static_cast<size_t>(max_cycles), (Initials_code)initial_solution_id);
+        sol = Optimize(sol, static_cast<size_t>(max_cycles), (Initials_code)initial_solution_id, time_limit);
 
         /*
          * get the solution
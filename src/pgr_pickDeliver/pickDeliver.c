@@ -45,6 +45,7 @@ process(
         double factor,
         int max_cycles,
         int initial_solution_id,
+        int timeout,
 
         Solution_rt **result_tuples,
         size_t *result_count) {
@@ -63,6 +64,7 @@ process(
             factor,
             max_cycles,
             initial_solution_id,
+            timeout,
 
             result_tuples,
             result_count,
@@ -102,6 +104,7 @@ _vrp_pgr_pickdeliver(PG_FUNCTION_ARGS) {
                 PG_GETARG_FLOAT8(3),
                 PG_GETARG_INT32(4),
                 PG_GETARG_INT32(5),
+                PG_GETARG_INT32(6),
                 &result_tuples,
                 &result_count);
 
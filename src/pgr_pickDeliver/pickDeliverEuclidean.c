@@ -45,6 +45,7 @@ process(
         double factor,
         int max_cycles,
         int initial_solution_id,
+        int timeout,
         Solution_rt **result_tuples,
         size_t *result_count) {
     char *log_msg = NULL;
@@ -61,6 +62,7 @@ process(
             factor,
             max_cycles,
             initial_solution_id,
+            timeout,
 
             result_tuples,
             result_count,
@@ -100,6 +102,7 @@ _vrp_pgr_pickdelivereuclidean(PG_FUNCTION_ARGS) {
                 PG_GETARG_FLOAT8(2),
                 PG_GETARG_INT32(3),
                 PG_GETARG_INT32(4),
+                PG_GETARG_INT32(5),
                 &result_tuples,
                 &result_count);
 
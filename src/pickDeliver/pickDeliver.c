@@ -52,6 +52,10 @@ process(
         int max_cycles,
         bool stop_on_all_served,
         int64_t execution_date,
+        int timeout,
+        int optimizer,
+        int threads,
+        int regret,
 
         bool  use_timestamps,
 
@@ -75,6 +79,10 @@ process(
             execution_date,
             optimize,
             stop_on_all_served,
+            timeout,
+            optimizer,
+            threads,
+            regret,
 
             use_timestamps,
             false,  // is_euclidean
@@ -128,6 +136,10 @@ _vrp_pickdeliver(PG_FUNCTION_ARGS) {
         PG_GETARG_INT32(6),
         PG_GETARG_BOOL(7),
         PG_GETARG_TIMEADT(8),
+        PG_GETARG_INT32(9),
+        PG_GETARG_INT32(10),
+        PG_GETARG_INT32(11),
+        PG_GETARG_INT32(12),
         true,
 
         &result_tuples,
@@ -221,6 +233,10 @@ _vrp_pickdeliverraw(PG_FUNCTION_ARGS) {
         PG_GETARG_INT32(6),
         PG_GETARG_BOOL(7),
         PG_GETARG_INT64(8),
+        PG_GETARG_INT32(9),
+        PG_GETARG_INT32(10),
+        PG_GETARG_INT32(11),
+        PG_GETARG_INT32(12),
         false,
 
         &result_tuples,
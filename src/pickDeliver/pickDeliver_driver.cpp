@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "drivers/pickDeliver_driver.h"
 
+#include <algorithm>
 #include <utility>
 #include <sstream>
 #include <string>
@@ -41,9 +42,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "cpp_common/assert.hpp"
 #include "cpp_common/pgdata_getters.hpp"
 #include "cpp_common/check_get_data.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "cpp_common/time_limit.hpp"
 #include "cpp_common/orders_t.hpp"
 #include "cpp_common/vehicle_t.hpp"
+#include "initialsol/regret.hpp"
 #include "initialsol/tabu.hpp"
+#include "optimizers/alns.hpp"
+#include "optimizers/multi_start.hpp"
+#include "optimizers/optimizers_code.hpp"
 #include "optimizers/tabu.hpp"
 #include "problem/matrix.hpp"
 #include "problem/pickDeliver.hpp"
@@ -61,6 +68,10 @@ vrp_do_pickDeliver(
 
         bool optimize,
         bool stop_on_all_served,
+        int timeout,
+        int optimizer,
+        int threads,
+        int regret,
 
         bool use_timestamps,
         bool is_euclidean,
@@ -97,6 +108,12 @@ vrp_do_pickDeliver(
         pgassert(*return_count == 0);
         pgassert(!(*return_tuples));
 
+        if (timeout < -1) {
+            *err_msg = to_pg_msg("Illegal value in parameter: timeout");
+            *log_msg = to_pg_msg("Expected value: timeout >= -1 (-1: no time limit)");
+            return;
+        }
+
         /*
          * Adjusting timestamp data to timezone UTC
          */
@@ -116,6 +133,29 @@ vrp_do_pickDeliver(
             return;
         }
 
+        if (optimizer < vrprouting::optimizers::TabuSearch || optimizer > vrprouting::optimizers::Alns) {
+            *err_msg = to_pg_msg("Illegal value in parameter: optimizer");
+            *log_msg = to_pg_msg("Expected value: 0 <= optimizer <= 1");
+            return;
+        }
+
+        if (threads < 1) {
+            *err_msg = to_pg_msg("Illegal value in parameter: threads");
+            *log_msg = to_pg_msg("Expected value: threads >= 1");
+            return;
+        }
+
+        if (regret < 0) {
+            *err_msg = to_pg_msg("Illegal value in parameter: regret");
+            *log_msg = to_pg_msg("Expected value: regret >= 0");
+            return;
+        }
+
+        /*
+         * the time given starts now
+         */
+        vrprouting::Time_limit time_limit(timeout);
+
         /* Data input starts */
 
         hint = orders_sql;
@@ -221,18 +261,39 @@ vrp_do_pickDeliver(
         log << "Finish constructing problem\n";
         pd_problem.msg.clear();
 
+        /*
+         * more threads than the hardware runs at the same time only slow down the search
+         */
+        auto n_threads = std::min(static_cast<size_t>(threads), vrprouting::hardware_threads());
+        if (n_threads < static_cast<size_t>(threads)) log << "threads reduced to " << n_threads << "\n";
+
         /*
          * get initial solutions
          */
         using Initial_solution = vrprouting::initialsol::tabu::Initial_solution;
         using Solution = vrprouting::problem::Solution;
         auto sol = static_cast<Solution>(Initial_solution(execution_date, optimize, pd_problem));
+        if (regret > 0) {
+            using Regret_insertion = vrprouting::initialsol::regret::Initial_solution;
+            sol = Regret_insertion(sol, static_cast<size_t>(regret), time_limit, n_threads);
+        }
 
         /*
          * Solve (optimize)
+         * - threads = 1: no worker threads
          */
-        using Optimize = vrprouting::optimizers::tabu::Optimize;
-        sol = Optimize(sol, static_cast<size_t>(max_cycles), stop_on_all_served, optimize);
+        if (optimizer == vrprouting::optimizers::Alns) {
+            using Optimize = vrprouting::optimizers::alns::Optimize;
+            sol = Optimize(sol, static_cast<size_t>(max_cycles), stop_on_all_served, optimize, time_limit,
+                    n_threads);
+        } else if (n_threads > 1) {
+            using Multi_start = vrprouting::optimizers::tabu::Multi_start;
+            sol = Multi_start(sol, static_cast<size_t>(max_cycles), stop_on_all_served, optimize, time_limit,
+                    n_threads);
+        } else {
+            using Optimize = vrprouting::optimizers::tabu::Optimize;
+            sol = Optimize(sol, static_cast<size_t>(max_cycles), stop_on_all_served, optimize, time_limit, 1);
+        }
 
         /*
          * get the solution
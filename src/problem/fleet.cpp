@@ -34,8 +34,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include <utility>
 #include <algorithm>
 
+#include "cpp_common/dynamic_bitset.hpp"
+#include "cpp_common/parallel_for.hpp"
 #include "cpp_common/vehicle_t.hpp"
 #include "cpp_common/short_vehicle.hpp"
+#include "problem/reachability.hpp"
 
 namespace vrprouting {
 namespace problem {
@@ -191,6 +194,7 @@ Fleet::is_order_ok(const Order &order) const {
 @param [in] vehicle
 @param [in] new_stops
 @param [in] p_orders
+@param [in] time_matrix
 @param [in,out] p_nodes
 @param [in,out] node_id
 */
@@ -199,6 +203,7 @@ Fleet::add_vehicle(
     const Vehicle_t &vehicle,
     const std::vector<Short_vehicle>& new_stops,
     const Orders& p_orders,
+    const Matrix& time_matrix,
     std::vector<Vehicle_node>& p_nodes,
     size_t& node_id) {
 
@@ -225,8 +230,8 @@ Fleet::add_vehicle(
     /**
      * Set the starting site and ending site
      */
-    auto starting_site = Vehicle_node({node_id++, vehicle, NodeType::kStart});
-    auto ending_site = Vehicle_node({node_id++, vehicle, NodeType::kEnd});
+    auto starting_site = Vehicle_node({node_id++, vehicle, NodeType::kStart, time_matrix});
+    auto ending_site = Vehicle_node({node_id++, vehicle, NodeType::kEnd, time_matrix});
 
     pgassert(starting_site.is_start() && ending_site.is_end());
 
@@ -308,48 +313,98 @@ Fleet::set_initial_solution(
         v.set_initial_solution(orders, assigned, unassigned, execution_date, optimize);
     }
 }
+
+/**
+ * @param [in] reachability the "can follow" matrices of the problem, one per speed
+ *
+ * A vehicle without a matrix for its speed keeps computing the compatibility of the nodes
+ */
+void
+Fleet::set_reachability(const std::vector<Reachability> &reachability) {
+    const Reachability *unit_reachability = nullptr;
+    for (const auto &r : reachability) {
+        if (r.speed() == 1.0) unit_reachability = &r;
+    }
+
+    for (auto &v : *this) {
+        const Reachability *vehicle_reachability = nullptr;
+        for (const auto &r : reachability) {
+            if (r.speed() == v.speed()) vehicle_reachability = &r;
+        }
+        v.set_reachability(vehicle_reachability, unit_reachability);
+    }
+}
+
 /**
 @param [in] orders set of orders to work with
+
+- The vehicles are indexed by the opening time of their starting site
+  - Only the vehicles that start before the order's delivery closes are visited
+- The feasibility test does not copy the vehicles
+- The orders are processed in parallel:
+  - each thread works on whole words of the vehicle x order bitset
 */
 void
 Fleet::set_compatibles(const Orders &orders) {
+    /*
+     * Interval index over the vehicles' shifts
+     */
+    std::vector<size_t> by_start(size());
+    std::iota(by_start.begin(), by_start.end(), 0);
+    std::stable_sort(by_start.begin(), by_start.end(),
+            [this](size_t lhs, size_t rhs) {
+                return at(lhs).start_site().opens() < at(rhs).start_site().opens();
+            });
+
+    /*
+     * compatible[v] has the orders that are feasible on the v-th vehicle
+     */
+    std::vector<Dynamic_bitset> compatible(size(), Dynamic_bitset(orders.size()));
+
     /**
      * Cycle the orders
      */
-    for (const auto &o : orders) {
-        /**
-         * Cycle the vehicles
-         */
-        for (auto & m_vehicle : *this) {
+    parallel_for(0, orders.size(), Dynamic_bitset::word_bits,
+            [&](size_t first, size_t last) {
+        for (auto o_idx = first; o_idx < last; ++o_idx) {
+            const auto &o = orders[o_idx];
+            pgassert(o.idx() == o_idx);
+
             /**
-             * - Skip orders that start after the vehicle closes
+             * - Skip the vehicles that start after the order's delivery closes
              */
-            if (m_vehicle.end_site().closes() < o.pickup().opens()) continue;
+            auto last_vehicle = std::upper_bound(by_start.begin(), by_start.end(), o.delivery().closes(),
+                    [this](TTimestamp closes, size_t v_idx) {
+                        return closes < at(v_idx).start_site().opens();
+                    });
 
             /**
-             * - Skip the orders that end before the vehicle starts
+             * Cycle the vehicles
              */
-            if (o.delivery().closes() < m_vehicle.start_site().opens()) continue;
-
-            if (m_vehicle.is_order_feasible(o)) {
-                m_msg.log << "Order " << o.id() << "is feasible on Vehicle " << m_vehicle.id() <<"\n";
-                auto test_truck =  m_vehicle;
-                test_truck.push_back(o);
-                m_msg.log << test_truck;
+            for (auto v_idx = by_start.begin(); v_idx != last_vehicle; ++v_idx) {
+                const auto &vehicle = at(*v_idx);
+                /**
+                 * - Skip the vehicles that close before the order starts
+                 */
+                if (vehicle.end_site().closes() < o.pickup().opens()) continue;
 
                 /**
                  * - The order is feasible in the vehicle so its compatible
                  */
-                m_vehicle.feasible_orders() += o.idx();
+                if (vehicle.is_order_feasible(o)) compatible[*v_idx].set(o_idx);
             }
-        }
 
-        /**
-         * Set compatibility on the phony vehicle
-         */
-        if (at(this->size() - 1).is_order_feasible(o)) {
-            at(this->size() - 1).feasible_orders() += o.idx();
+            /**
+             * Set compatibility on the phony vehicle
+             */
+            if (!compatible.back().test(o_idx) && back().is_order_feasible(o)) {
+                compatible.back().set(o_idx);
+            }
         }
+    });
+
+    for (size_t v_idx = 0; v_idx < size(); ++v_idx) {
+        at(v_idx).feasible_orders() += Identifiers<size_t>(compatible[v_idx]);
     }
 }
 
@@ -359,6 +414,7 @@ Fleet::set_compatibles(const Orders &orders) {
   @param[in] vehicles  the list of vehicles
   @param [in] new_stops overides vehicles stops
   @param[in] p_orders
+  @param[in] time_matrix
   @param[in,out] p_nodes
   @param[in,out] node_id
   */
@@ -366,6 +422,7 @@ void Fleet::build_fleet(
     std::vector<Vehicle_t> vehicles,
     const std::vector<Short_vehicle>& new_stops,
     const Orders& p_orders,
+    const Matrix& time_matrix,
     std::vector<Vehicle_node>& p_nodes,
     size_t& node_id) {
     /**
@@ -388,7 +445,7 @@ void Fleet::build_fleet(
      * Add the vehicles
      */
     for (const auto &v : vehicles) {
-        add_vehicle(v, new_stops, p_orders, p_nodes, node_id);
+        add_vehicle(v, new_stops, p_orders, time_matrix, p_nodes, node_id);
     }
 
     /**
@@ -429,7 +486,7 @@ void Fleet::build_fleet(
     /*
      * Add the phony vehicle
      */
-    add_vehicle(phony_v, new_stops, p_orders, p_nodes, node_id);
+    add_vehicle(phony_v, new_stops, p_orders, time_matrix, p_nodes, node_id);
 
     Identifiers<size_t> unused(this->size());
     m_size = size();
@@ -442,20 +499,22 @@ void Fleet::build_fleet(
 Fleet::Fleet(
         const std::vector<Vehicle_t> &vehicles,
         const Orders& p_orders,
+        const Matrix& time_matrix,
         std::vector<Vehicle_node>& p_nodes,
         size_t& node_id)
     : m_used(), m_unused() {
-        build_fleet(vehicles, {}, p_orders, p_nodes, node_id);
+        build_fleet(vehicles, {}, p_orders, time_matrix, p_nodes, node_id);
     }
 
 Fleet::Fleet(
         const std::vector<Vehicle_t> &vehicles,
         const std::vector<Short_vehicle> &new_stops,
         const Orders& p_orders,
+        const Matrix& time_matrix,
         std::vector<Vehicle_node>& p_nodes,
         size_t& node_id)
     : m_used(), m_unused() {
-        build_fleet(vehicles, new_stops, p_orders, p_nodes, node_id);
+        build_fleet(vehicles, new_stops, p_orders, time_matrix, p_nodes, node_id);
     }
 
 }  // namespace problem
@@ -230,8 +230,36 @@ Matrix::travel_time(Id i, Id j, TTimestamp date_time_of_departure_from_i) const
      */
     if (!has_id(i) || !has_id(j)) return (std::numeric_limits<TInterval>::max)();
 
+    return travel_time_by_index(get_index(i), get_index(j), date_time_of_departure_from_i);
+}
+
+/**
+ * @param[in] i,j indices of the nodes on the matrix
+ * @param[in] date_time_of_departure_from_i time of departure from i
+ *
+ * @return the cell content adjusted with the time dependant multipliers
+ *
+ * @pre i and j are valid indices: the nodes store them, so there is no look up of the original identifiers
+ */
+TInterval
+Matrix::travel_time_by_index(Idx i, Idx j, TTimestamp date_time_of_departure_from_i) const {
+    return is_time_dependent() ?
+        time_dependent_travel_time(i, j, date_time_of_departure_from_i) :
+        at(i, j);
+}
+
+/**
+ * @param[in] i,j indices of the nodes on the matrix
+ * @param[in] date_time_of_departure_from_i time of departure from i
+ *
+ * @return the cell content adjusted with the time dependant multipliers
+ *
+ * @pre is_time_dependent()
+ */
+TInterval
+Matrix::time_dependent_travel_time(Idx i, Idx j, TTimestamp date_time_of_departure_from_i) const {
     /* data */
-    double tt_i_j {static_cast<double>(at(get_index(i), get_index(j)))};
+    double tt_i_j {static_cast<double>(at(i, j))};
     double c1(get_tdm(m_multipliers, date_time_of_departure_from_i));
     double c2(next_tdm(m_multipliers, date_time_of_departure_from_i));
     auto t_change(time_change(m_multipliers, date_time_of_departure_from_i));
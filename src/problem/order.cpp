@@ -43,7 +43,9 @@ namespace problem {
   */
 Identifiers<size_t>
 Order::subsetI(const Identifiers<size_t> &I) const {
-  return m_compatibleI * I;
+  auto result(I.bits());
+  result &= m_compatibleI;
+  return Identifiers<size_t>(result);
 }
 
 /**
@@ -60,7 +62,9 @@ Order::subsetI(const Identifiers<size_t> &I) const {
 */
 Identifiers<size_t>
 Order::subsetJ(const Identifiers<size_t> &J) const {
-  return m_compatibleJ * J;
+  auto result(J.bits());
+  result &= m_compatibleJ;
+  return Identifiers<size_t>(result);
 }
 
 /**
@@ -80,15 +84,15 @@ operator<< (std::ostream &log, const Order &order) {
     << "\tPickup: " << order.pickup() << "\n"
     << "\tDropoff: " << order.delivery() << "\n";
   log << "\nThere are | {I}| = "
-    << order.m_compatibleI.size()
+    << order.m_compatibleI.count()
     << " -> order(" << order.idx()
-    << ") -> | {J}| = " << order.m_compatibleJ.size()
+    << ") -> | {J}| = " << order.m_compatibleJ.count()
     << "\n\n {";
-  for (const auto o : order.m_compatibleI) {
+  for (auto o = order.m_compatibleI.find_first(); o < order.m_compatibleI.size(); o = order.m_compatibleI.find_next(o + 1)) {
     log << o << ", ";
   }
   log << "} -> " << order.idx() << " -> {";
-  for (const auto o : order.m_compatibleJ) {
+  for (auto o = order.m_compatibleJ.find_first(); o < order.m_compatibleJ.size(); o = order.m_compatibleJ.find_next(o + 1)) {
     log << o << ", ";
   }
   log << "}";
@@ -130,13 +134,23 @@ void
 Order::set_compatibles(const Order& J, Speed speed) {
   if (J.idx() == idx()) return;
   if (J.isCompatibleIJ(*this, speed)) {
-    m_compatibleJ += J.idx();
+    m_compatibleJ.set(J.idx());
   }
   if (this->isCompatibleIJ(J, speed)) {
-    m_compatibleI += J.idx();
+    m_compatibleI.set(J.idx());
   }
 }
 
+/**
+ * @param [in] n_orders total number of orders
+ * @post the compatibility storage holds @b n_orders orders, so setting the compatibility does not reallocate
+ */
+void
+Order::reserve_compatibles(size_t n_orders) {
+  m_compatibleJ.resize(n_orders);
+  m_compatibleI.resize(n_orders);
+}
+
 /**
   @returns True when I -> @b this
   @dot
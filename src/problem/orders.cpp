@@ -33,6 +33,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "cpp_common/assert.hpp"
 #include "cpp_common/identifiers.hpp"
 #include "cpp_common/orders_t.hpp"
+#include "cpp_common/parallel_for.hpp"
 #include "problem/pickDeliver.hpp"
 
 
@@ -42,7 +43,6 @@ namespace problem {
 Orders::Orders(
         const std::vector<Orders_t> &p_orders,
         PickDeliver &problem_ptr) {
-    Tw_node::m_time_matrix_ptr = &(problem_ptr.time_matrix());
     build_orders(p_orders, problem_ptr);
 }
 
@@ -57,9 +57,10 @@ Orders::find_best_J(
     pgassert(!within_this_set.empty());
     auto best_order = within_this_set.front();
     size_t max_size = 0;
+    const auto &within(within_this_set.bits());
 
     for (const auto o : within_this_set) {
-        auto size_J =  this->at(o).subsetJ(within_this_set).size();
+        auto size_J =  this->at(o).compatibleJ().count_and(within);
         if (max_size < size_J) {
             max_size = size_J;
             best_order = o;
@@ -79,8 +80,10 @@ Orders::find_best_I(
     pgassert(!within_this_set.empty());
     auto best_order = within_this_set.front();
     size_t max_size = 0;
+    const auto &within(within_this_set.bits());
+
     for (const auto o : within_this_set) {
-        auto size_I =  this->at(o).subsetI(within_this_set).size();
+        auto size_I =  this->at(o).compatibleI().count_and(within);
         if (max_size < size_I) {
             max_size = size_I;
             best_order = o;
@@ -100,10 +103,11 @@ Orders::find_best_I_J(
     pgassert(!within_this_set.empty());
     auto best_order = within_this_set.front();
     size_t max_size = 0;
+    const auto &within(within_this_set.bits());
 
     for (const auto o : within_this_set) {
-        auto size_I =  this->at(o).subsetI(within_this_set).size();
-        auto size_J =  this->at(o).subsetJ(within_this_set).size();
+        auto size_I =  this->at(o).compatibleI().count_and(within);
+        auto size_J =  this->at(o).compatibleJ().count_and(within);
         if (max_size < (std::max)(size_I, size_J)) {
             max_size = (std::max)(size_I, size_J);
             best_order = o;
@@ -132,14 +136,20 @@ Orders::is_valid(Speed speed) const {
 /**
 @post For each order: order -> {J} is set
 @post For each order: {I} -> order is set
+
+Each order only writes its own compatibility, so the orders are processed in parallel
 */
 void
 Orders::set_compatibles(Speed speed) {
-    for (auto &I : *this) {
-        for (const auto& J : *this) {
-            I.set_compatibles(J, speed);
+    parallel_for(0, size(), 1, [&](size_t first, size_t last) {
+        for (auto i = first; i < last; ++i) {
+            auto &I = (*this)[i];
+            I.reserve_compatibles(size());
+            for (const auto& J : *this) {
+                I.set_compatibles(J, speed);
+            }
         }
-    }
+    });
 }
 
 /**
@@ -167,8 +177,8 @@ Orders::build_orders(
       });
 
     for (const auto &o : orders) {
-        Vehicle_node pick({problem_ptr.node_id()++, o, NodeType::kPickup});
-        Vehicle_node drop({problem_ptr.node_id()++, o, NodeType::kDelivery});
+        Vehicle_node pick({problem_ptr.node_id()++, o, NodeType::kPickup, problem_ptr.time_matrix()});
+        Vehicle_node drop({problem_ptr.node_id()++, o, NodeType::kDelivery, problem_ptr.time_matrix()});
 
         problem_ptr.add_node(pick);
         problem_ptr.add_node(drop);
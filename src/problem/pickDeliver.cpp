@@ -25,6 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "problem/pickDeliver.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <utility>
 #include "c_types/compatibleVehicles_rt.h"
@@ -37,6 +38,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "problem/orders.hpp"
 #include "problem/fleet.hpp"
 #include "problem/matrix.hpp"
+#include "problem/reachability.hpp"
 
 namespace vrprouting {
 namespace problem {
@@ -47,9 +49,10 @@ PickDeliver::PickDeliver(
         const Matrix &p_cost_matrix) :
     m_cost_matrix(p_cost_matrix),
     m_orders(p_orders, *this),
-    m_trucks(p_vehicles, m_orders, m_nodes, m_node_id) {
+    m_trucks(p_vehicles, m_orders, m_cost_matrix, m_nodes, m_node_id) {
         if (!msg.get_error().empty()) return;
         m_trucks.clean();
+        set_reachability();
         m_orders.set_compatibles();
         m_trucks.set_compatibles(m_orders);
     }
@@ -62,14 +65,38 @@ PickDeliver::PickDeliver(
         const Matrix &p_cost_matrix) :
     m_cost_matrix(p_cost_matrix),
     m_orders(p_orders, *this),
-    m_trucks(p_vehicles, new_stops, m_orders, m_nodes, m_node_id) {
+    m_trucks(p_vehicles, new_stops, m_orders, m_cost_matrix, m_nodes, m_node_id) {
         if (!msg.get_error().empty()) return;
         m_trucks.clean();
+        set_reachability();
         m_orders.set_compatibles();
         m_trucks.set_compatibles(m_orders);
     }
 
 
+/**
+ * - Speed 1 is always considered: the lowest insertion position is computed with speed 1
+ * - The speeds of the vehicles are considered in the order of the fleet
+ * - No more matrices are computed once max_reachability_bits would be exceeded
+ */
+void
+PickDeliver::set_reachability() {
+    std::vector<Speed> speeds {1.0};
+    for (const auto &v : m_trucks) {
+        if (std::find(speeds.begin(), speeds.end(), v.speed()) == speeds.end()) speeds.push_back(v.speed());
+    }
+
+    auto bits_per_speed = Reachability::bits(m_nodes.size());
+    m_reachability.reserve(speeds.size());
+    size_t bits_used = 0;
+    for (const auto speed : speeds) {
+        if (bits_used + bits_per_speed > max_reachability_bits) break;
+        m_reachability.emplace_back(m_nodes, speed);
+        bits_used += bits_per_speed;
+    }
+    m_trucks.set_reachability(m_reachability);
+}
+
 /** @brief get the vehicles compatibility results as C++ container */
 std::vector<CompatibleVehicles_rt> PickDeliver::get_pg_compatibleVehicles() const {
     std::vector<CompatibleVehicles_rt> result;
@@ -0,0 +1,59 @@
+/*PGR-GNU*****************************************************************
+
+FILE: reachability.cpp
+
+Copyright (c) 2024 pgRouting developers
+Mail: pgrouting-dev@discourse.osgeo.org
+
+------
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ ********************************************************************PGR-GNU*/
+
+#include "problem/reachability.hpp"
+
+#include <vector>
+
+#include "cpp_common/assert.hpp"
+#include "cpp_common/parallel_for.hpp"
+#include "problem/vehicle_node.hpp"
+
+namespace vrprouting {
+namespace problem {
+
+/**
+ * @param [in] nodes all the nodes of the problem: nodes[i].idx() == i
+ * @param [in] speed used to compute the travel times
+ *
+ * The rows are computed in parallel: each row is on its own words of the bitset
+ */
+Reachability::Reachability(const std::vector<Vehicle_node> &nodes, Speed speed) :
+    m_speed(speed),
+    m_row_bits(row_bits(nodes.size())),
+    m_bits(bits(nodes.size())) {
+        parallel_for(0, nodes.size(), 1, [&](size_t first, size_t last) {
+            for (auto i = first; i < last; ++i) {
+                const auto &I = nodes[i];
+                pgassert(I.idx() == i);
+                for (const auto &J : nodes) {
+                    if (J.is_compatible_IJ(I, m_speed)) m_bits.set(i * m_row_bits + J.idx());
+                }
+            }
+        });
+    }
+
+}  // namespace problem
+}  // namespace vrprouting
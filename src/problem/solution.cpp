@@ -34,6 +34,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include <algorithm>
 #include <tuple>
 #include <iomanip>
+#include <utility>
+#include "cpp_common/assert.hpp"
 #include "problem/pickDeliver.hpp"
 #include "cpp_common/short_vehicle.hpp"
 #include "c_types/solution_rt.h"
@@ -321,6 +323,25 @@ Solution::objective() const {
     return static_cast<double>(total_travel_time());
 }
 
+/**
+ * Sorting the positions of the vehicles instead of the vehicles:
+ * each vehicle is moved once, and not moved at all when the fleet is already arranged
+ *
+ * @param [in] positions the vehicle on positions[i] goes to position i
+ * @pre positions is a permutation of the positions of the fleet
+ */
+void
+Solution::arrange_fleet(const std::vector<size_t> &positions) {
+    pgassert(positions.size() == m_fleet.size());
+    size_t i = 0;
+    while (i < positions.size() && positions[i] == i) ++i;
+    if (i == positions.size()) return;
+
+    std::deque<Vehicle_pickDeliver> arranged;
+    for (const auto p : positions) arranged.push_back(std::move(m_fleet[p]));
+    m_fleet = std::move(arranged);
+}
+
 Solution::Solution(PickDeliver &p_problem) :
     m_orders(p_problem.orders()),
     m_trucks(p_problem.vehicles()),
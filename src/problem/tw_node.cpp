@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include <limits>
 #include <string>
+#include <utility>
 
 #include "cpp_common/assert.hpp"
 #include "problem/matrix.hpp"
@@ -37,9 +38,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 namespace vrprouting {
 namespace problem {
 
-const Matrix* Tw_node::m_time_matrix_ptr = nullptr;
-
-
 /**
  * @param [in] other - pointer to the other Tw_node
  * @param [in] time - time of departure from previous node
@@ -50,7 +48,23 @@ const Matrix* Tw_node::m_time_matrix_ptr = nullptr;
 TInterval
 Tw_node::travel_time_to(const Tw_node &other, TTimestamp time, Speed speed) const {
   pgassert(speed != 0);
-  return static_cast<TInterval>(static_cast<Speed>(m_time_matrix_ptr->travel_time(id(), other.id(), time)) / speed);
+  auto travel_time = m_time_matrix_ptr->travel_time_by_index(m_matrix_idx, other.m_matrix_idx, time);
+  return static_cast<TInterval>(static_cast<Speed>(travel_time) / speed);
+}
+
+/**
+ * @post m_matrix_idx has the index of the node on the time matrix
+ *
+ * @throws std::pair<std::string, std::string> when the node is not on the time matrix
+ */
+void
+Tw_node::set_matrix_idx() {
+  if (!m_time_matrix_ptr->has_id(id())) {
+    throw std::make_pair(
+        std::string("(INTERNAL) Tw_node: Unable to find node on matrix"),
+        std::string("Node identifier ") + std::to_string(id()) + " is not on the time matrix");
+  }
+  m_matrix_idx = m_time_matrix_ptr->get_index(id());
 }
 
 /**
@@ -309,18 +323,21 @@ bool Tw_node::is_valid() const {
   @param [in] id the internal id of the node
   @param [in] data the postgrSQL order information
   @param [in] type the kind of node to be created
+  @param [in] time_matrix the time matrix of the problem
   */
 Tw_node::Tw_node(
     size_t id,
     const Orders_t &data,
-    const NodeType &type) :
+    const NodeType &type,
+    const Matrix &time_matrix) :
   Identifier(id, data.pick_node_id),
   m_order(data.id),
   m_opens(data.pick_open_t),
   m_closes(data.pick_close_t),
   m_service_time(data.pick_service_t),
   m_demand(data.demand),
-  m_type(type)  {
+  m_type(type),
+  m_time_matrix_ptr(&time_matrix)  {
     if (m_type == kDelivery) {
       reset_id(data.deliver_node_id);
       m_opens = data.deliver_open_t;
@@ -328,29 +345,34 @@ Tw_node::Tw_node(
       m_service_time = data.deliver_service_t;
       m_demand *= -1;
     }
+    set_matrix_idx();
   }
 
 /**
   @param [in] id the internal id of the node
   @param [in] data the postgrSQL vehicle information
   @param [in] type the kind of node to be created
+  @param [in] time_matrix the time matrix of the problem
   */
 Tw_node::Tw_node(
     size_t id,
     const Vehicle_t &data,
-    const NodeType &type) :
+    const NodeType &type,
+    const Matrix &time_matrix) :
   Identifier(id, data.start_node_id),
   m_opens(data.start_open_t),
   m_closes(data.start_close_t),
   m_service_time(data.start_service_t),
   m_demand(0),
-  m_type(type) {
+  m_type(type),
+  m_time_matrix_ptr(&time_matrix) {
     if (m_type == kEnd) {
       reset_id(data.end_node_id);
       m_opens = data.end_open_t;
       m_closes = data.end_close_t;
       m_service_time = data.end_service_t;
     }
+    set_matrix_idx();
   }
 
 
@@ -40,6 +40,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "cpp_common/assert.hpp"
 #include "cpp_common/identifier.hpp"
 #include "problem/vehicle_node.hpp"
+#include "problem/travel_time_policy.hpp"
 
 namespace vrprouting {
 namespace problem {
@@ -127,12 +128,34 @@ void Vehicle::evaluate() {evaluate(0);}
 
 /**
  * @param[in] from The position in the path for evaluation to the end of the path.
+ *
+ * The kind of matrix, the storage of its cells and the kind of speed are decided here, once for the whole path
 */
 void Vehicle::evaluate(size_t from) {
   invariant();
   // preconditions
   pgassert(from < size());
 
+  if (front().time_matrix().is_time_dependent()) {
+    if (speed() == 1.0) {
+      evaluate_path<Travel_time<Time_dependent_matrix, Unit_speed>>(from);
+    } else {
+      evaluate_path<Travel_time<Time_dependent_matrix, Scaled_speed>>(from);
+    }
+  } else {
+    with_static_travel_time(front().time_matrix(), speed(), [&](auto travel) {
+        evaluate_path<decltype(travel)>(from);
+        });
+  }
+  invariant();
+}
+
+/**
+ * @tparam Travel travel time policy
+ * @param[in] from The position in the path for evaluation to the end of the path.
+*/
+template <typename Travel>
+void Vehicle::evaluate_path(size_t from) {
   using difference_type = std::vector<Vehicle_node>::difference_type;
   auto node = begin() + static_cast<difference_type>(from);
 
@@ -140,12 +163,11 @@ void Vehicle::evaluate(size_t from) {
     if (node == begin()) {
       node->evaluate(capacity());
     } else {
-      node->evaluate(*(node - 1), capacity(), speed());
+      node->evaluate<Travel>(*(node - 1), capacity(), speed());
     }
 
     ++node;
   }
-  invariant();
 }
 
 
@@ -337,7 +359,7 @@ Vehicle::getDropPosLowLimit(const Vehicle_node &nodeI) const {
 
   /* J == m_path[low_limit - 1] */
   while (low_limit > low
-      && at(low_limit - 1).is_compatible_IJ(nodeI, speed())
+      && can_follow(m_reachability, nodeI, at(low_limit - 1), speed())
       && !at(low_limit - 1).is_pickup()) {
     --low_limit;
   }
@@ -372,7 +394,7 @@ Vehicle::getPosLowLimit(const Vehicle_node &nodeI) const {
 
   /* J == m_path[low_limit - 1] */
   while (low_limit > low
-      && at(low_limit - 1).is_compatible_IJ(nodeI)) {
+      && can_follow(m_unit_reachability, nodeI, at(low_limit - 1), 1.0)) {
     --low_limit;
   }
 
@@ -403,7 +425,7 @@ Vehicle::getPosHighLimit(const Vehicle_node &nodeJ) const {
 
   /* I == m_path[high_limit] */
   while (high_limit < high
-      && nodeJ.is_compatible_IJ(at(high_limit), speed())) {
+      && can_follow(m_reachability, at(high_limit), nodeJ, speed())) {
     ++high_limit;
   }
 
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "problem/vehicle_node.hpp"
 #include "cpp_common/assert.hpp"
+#include "cpp_common/fingerprint_set.hpp"
 #include "c_types/solution_rt.h"
 
 
@@ -69,6 +70,9 @@ Vehicle_node::evaluate(PAmount cargoLimit) {
   m_twvTot = m_cvTot = 0;
   m_cvTot = has_cv(cargoLimit) ? 1 : 0;
   m_delta_time = 0;
+
+  /* path */
+  m_path_hash = hash_token();
 }
 
 
@@ -83,8 +87,23 @@ Vehicle_node::evaluate(
     PAmount cargoLimit,
     Speed speed
     ) {
+  evaluate_arrival(pred, cargoLimit, pred.travel_time_to(*this, pred.departure_time(), speed));
+}
+
+
+/**
+  @param[in] pred The node preceding this node in the path.
+  @param[in] cargoLimit of the vehicle.
+  @param[in] arc_time travel time from @b pred to this node
+  */
+void
+Vehicle_node::evaluate_arrival(
+    const Vehicle_node &pred,
+    PAmount cargoLimit,
+    TInterval arc_time
+    ) {
   /* time */
-  m_travel_time    = pred.travel_time_to(*this, pred.departure_time(), speed);
+  m_travel_time    = arc_time;
   m_arrival_time   = pred.departure_time() + travel_time();
   m_wait_time      = is_early_arrival(arrival_time()) ?
     opens() - m_arrival_time :
@@ -107,6 +126,21 @@ Vehicle_node::evaluate(
   m_twvTot = has_twv() ? pred.twvTot() + 1 : pred.twvTot();
   m_cvTot = has_cv(cargoLimit) ? pred.cvTot() + 1 : pred.cvTot();
   m_delta_time = departure_time() - pred.departure_time();
+
+  /* path */
+  m_path_hash = hash_combine(pred.path_hash(), hash_token());
+}
+
+
+/**
+ * @returns the hash of the kind of node, and for nodes that are not starting or ending nodes, of the order
+ */
+uint64_t
+Vehicle_node::hash_token() const {
+  auto kind = static_cast<uint64_t>(type());
+  return (type() == kStart || type() == kEnd) ?
+    hash_mix(kind) :
+    hash_combine(kind, static_cast<uint64_t>(order()));
 }
 
 
@@ -150,7 +184,8 @@ Vehicle_node::Vehicle_node(const Tw_node &node)
   m_cvTot(0),
   m_tot_wait_time(0),
   m_tot_travel_time(0),
-  m_tot_service_time(0) {
+  m_tot_service_time(0),
+  m_path_hash(0) {
   }
 
 
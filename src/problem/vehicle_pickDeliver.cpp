@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #include "problem/vehicle_pickDeliver.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -34,6 +35,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 #include "problem/vehicle.hpp"
 #include "problem/order.hpp"
 #include "problem/orders.hpp"
+#include "problem/route_snapshot.hpp"
+#include "problem/intra_route.hpp"
 
 namespace vrprouting {
 namespace problem {
@@ -175,6 +178,57 @@ Vehicle_pickDeliver::erase(const Order &order) {
   pgassert(!has_order(order));
 }
 
+/**
+ * Applies the best relocate, or-opt or exchange move of the route until no move reduces the travel time
+ *
+ * Only the nodes of the orders in m_orders_in_vehicle are moved
+ *
+ * @returns true when the travel time of the route was reduced
+ *
+ * The moves are evaluated when the matrix is not time dependent and the vehicle does not accept violations,
+ * otherwise the route does not change.
+ */
+bool
+Vehicle_pickDeliver::improve_route() {
+  if (is_phony() || orders_size() == 0) return false;
+  if (front().time_matrix().is_time_dependent() || m_user_twv != 0 || m_user_cv != 0) return false;
+  if (!is_feasible()) return false;
+
+  std::vector<int64_t> movable_orders;
+  for (const auto o : m_orders_in_vehicle) movable_orders.push_back(orders()[o].id());
+  std::sort(movable_orders.begin(), movable_orders.end());
+
+  bool improved = false;
+  std::vector<size_t> sequence;
+  for (;;) {
+    std::vector<bool> movable;
+    movable.reserve(size());
+    for (const auto &node : *this) {
+      movable.push_back((node.is_pickup() || node.is_delivery())
+          && std::binary_search(movable_orders.begin(), movable_orders.end(), node.order()));
+    }
+
+    auto found = with_static_travel_time(front().time_matrix(), speed(), [&](auto travel) {
+        return Intra_route<decltype(travel)>(begin(), end(), movable, capacity(), speed()).best_move(sequence);
+        });
+    if (!found) break;
+
+    auto old_route = route();
+    auto old_travel_time = total_travel_time();
+    for (size_t i = 0; i < sequence.size(); ++i) at(i) = old_route.nodes[sequence[i]];
+    evaluate(1);
+
+    /* the evaluation of the moves is exact: the route is only restored if the evaluation of the move is wrong */
+    if (!is_feasible() || total_travel_time() >= old_travel_time) {
+      set_route(old_route);
+      break;
+    }
+    improved = true;
+  }
+  invariant();
+  return improved;
+}
+
 /**
   @param [in] orders from the problem
   @param [in] assigned set of orders ids already assigned
@@ -344,16 +398,50 @@ double Vehicle_pickDeliver::objective() const {
     static_cast<double>(total_travel_time());
 }
 
+/**
+ * The nodes are already evaluated, so the route can be set back without evaluating it again
+ */
+Vehicle_pickDeliver::Route
+Vehicle_pickDeliver::route() const {
+  return {std::vector<Vehicle_node>(begin(), end()), m_orders_in_vehicle};
+}
+
+/**
+ * @param [in] route taken from this vehicle (or from a copy of it)
+ *
+ * @pre the route was taken with route() on this vehicle or on a vehicle with the same data
+ */
+void
+Vehicle_pickDeliver::set_route(const Route &route) {
+  pgassert(route.nodes.size() >= 2);
+  pgassert(route.nodes.front().is_start() && route.nodes.back().is_end());
+  assign(route.nodes.begin(), route.nodes.end());
+  m_orders_in_vehicle = route.orders_in_vehicle;
+  invariant();
+}
+
 /**
  * @returns ture when the order is feasible on the vehicle
  * @param [in] order to be tested
  * @pre vehicle is empty
+ *
+ * The path S P D E is evaluated on local nodes, the vehicle is not copied
  */
 bool
 Vehicle_pickDeliver::is_order_feasible(const Order &order) const {
-  auto test_truck =  *this;
-  test_truck.push_back(order);
-  return test_truck.is_feasible();
+  if (!empty()) {
+    auto test_truck =  *this;
+    test_truck.push_back(order);
+    return test_truck.is_feasible();
+  }
+
+  auto pick(order.pickup());
+  auto drop(order.delivery());
+  auto ending(end_site());
+  pick.evaluate(start_site(), capacity(), speed());
+  drop.evaluate(pick, capacity(), speed());
+  ending.evaluate(drop, capacity(), speed());
+  return !(ending.twvTot() > m_user_twv || ending.cvTot() > m_user_cv);
 }
 
 /**
@@ -400,6 +488,31 @@ Vehicle_pickDeliver::semiLIFO(const Order &order) {
     return false;
   }
 
+  if (!front().time_matrix().is_time_dependent() && m_user_twv == 0 && m_user_cv == 0) {
+    /*
+     * Find the position on a snapshot of the route
+     */
+    auto route_size = size();
+    auto drop_pos = with_static_travel_time(front().time_matrix(), speed(), [&](auto travel) {
+        return Route_snapshot<decltype(travel)>(begin(), end(), capacity(), speed()).lifo_drop_position(
+            order.delivery(), deliver_pos);
+        });
+
+    if (drop_pos == route_size) {
+      erase(1);
+      pgassert(!has_order(order));
+      invariant();
+      return false;
+    }
+
+    insert(drop_pos, order.delivery());
+    m_orders_in_vehicle += order.idx();
+    pgassert(has_order(order));
+    pgassert(is_feasible());
+    invariant();
+    return true;
+  }
+
   pgassert(!has_order(order));
   while (deliver_pos.first <= deliver_pos.second) {
     insert(deliver_pos.second, order.delivery());
@@ -490,6 +603,26 @@ Vehicle_pickDeliver::hillClimb(const Order &order) {
   ++deliver_pos.first;
   ++deliver_pos.second;
 
+  if (!front().time_matrix().is_time_dependent() && m_user_twv == 0 && m_user_cv == 0) {
+    /*
+     * Evaluate all the positions on a snapshot of the route
+     */
+    auto best = with_static_travel_time(front().time_matrix(), speed(), [&](auto travel) {
+        return Route_snapshot<decltype(travel)>(begin(), end(), capacity(), speed()).best_insertion(
+            order.pickup(), order.delivery(), pick_pos, deliver_pos, !is_phony());
+        });
+
+    if (!best.found) return false;
+
+    insert(best.pick_pos, order.pickup());
+    insert(best.drop_pos, order.delivery());
+    m_orders_in_vehicle += order.idx();
+
+    pgassert(is_feasible());
+    invariant();
+    return true;
+  }
+
 
   auto best_pick_pos = size();
   auto best_deliver_pos = size() + 1;
@@ -559,6 +692,25 @@ Vehicle_pickDeliver::hillClimb(const Order &order) {
   return true;
 }
 
+/**
+ * The order is inserted with hillClimb and the route is restored:
+ * erasing the order is not enough, hillClimb can leave the other nodes in a different order
+ *
+ * @param [in] order to be inserted
+ * @returns the increase of the travel time, infeasible_delta when the order can not be inserted
+ *
+ * @pre !has_order(order)
+ * @post the vehicle has the same route
+ */
+TInterval
+Vehicle_pickDeliver::insertion_delta(const Order &order) {
+  auto original = route();
+  auto travel_time = total_travel_time();
+  auto delta = hillClimb(order) ? total_travel_time() - travel_time : infeasible_delta;
+  set_route(original);
+  return delta;
+}
+
 const Orders& Vehicle_pickDeliver::orders() const {
      pgassert(m_orders.size() != 0);
      return m_orders;